@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+#
+# Benchmark decoding of all messages in vehicle.dbc with the compiled
+# decoders and with the generic bitstruct based decoder.
+#
+# > python3 decode.py
+# vehicle.dbc (217 messages, 100 iterations):
+#   generic:  0.299 s
+#   compiled: 0.026 s (11.7x)
+#
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import load_dbc
+from utils import measure
+
+
+ITERATIONS = 100
+
+
+def main():
+    database = load_dbc('vehicle.dbc')
+    frames = [
+        (message, bytes(range(1, message.length + 1)))
+        for message in database.messages
+    ]
+
+    def generic():
+        for message, data in frames:
+            message._decode(message._codecs, data, True, True)
+
+    def compiled():
+        for message, data in frames:
+            message.decode(data)
+
+    print('{} ({} messages, {} iterations):'.format('vehicle.dbc',
+                                                     len(frames),
+                                                     ITERATIONS))
+    generic_elapsed = measure(generic, ITERATIONS)
+    compiled_elapsed = measure(compiled, ITERATIONS)
+    print('  generic:  {:.3f} s'.format(generic_elapsed))
+    print('  compiled: {:.3f} s ({:.1f}x)'.format(
+        compiled_elapsed,
+        generic_elapsed / compiled_elapsed))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+#
+# Benchmark decoding of a recorded bus, where most frames repeat the
+# previous payload of their message, with and without the decode
+# cache.
+#
+# > python3 decode_cache.py
+# vehicle.dbc (100000 frames, 10% changed payloads):
+#   no cache:   0.314 s
+#   last value: 0.206 s
+# abs.dbc (100000 frames, 10% changed payloads):
+#   no cache:   0.207 s
+#   last value: 0.195 s
+#
+
+import os
+import sys
+import random
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import load_dbc
+from utils import measure
+
+
+NUMBER_OF_FRAMES = 100000
+CHANGE_PROBABILITY = 0.1
+
+
+def benchmark(name):
+    database = load_dbc(name)
+    random.seed(0)
+    payloads = {}
+    frames = []
+
+    for _ in range(NUMBER_OF_FRAMES):
+        message = random.choice(database.messages)
+
+        if (message.name not in payloads
+            or random.random() < CHANGE_PROBABILITY):
+            payloads[message.name] = bytes(random.getrandbits(8)
+                                           for _ in range(message.length))
+
+        frames.append((message.frame_id, payloads[message.name]))
+
+    def decode():
+        for frame_id, payload in frames:
+            try:
+                database.decode_message(frame_id, payload)
+            except Exception:
+                pass
+
+    print('{} ({} frames, {:.0f}% changed payloads):'.format(
+        name,
+        NUMBER_OF_FRAMES,
+        100 * CHANGE_PROBABILITY))
+    print('  no cache:   {:.3f} s'.format(measure(decode)))
+    database.enable_decode_cache()
+    print('  last value: {:.3f} s'.format(measure(decode)))
+
+
+def main():
+    for name in ['vehicle.dbc', 'abs.dbc']:
+        benchmark(name)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+#
+# Benchmark decoding of recorded frames of all messages in
+# vehicle.dbc, one frame at a time and in batches into NumPy arrays.
+#
+# > python3 decode_frames.py
+# vehicle.dbc (100000 frames):
+#   decode_message: 0.343 s
+#   decode_frames:  0.146 s
+#
+
+import os
+import sys
+import random
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import load_dbc
+from utils import measure
+
+
+NUMBER_OF_FRAMES = 100000
+
+
+def main():
+    database = load_dbc('vehicle.dbc')
+    random.seed(0)
+    frame_ids = []
+    payloads = []
+
+    for _ in range(NUMBER_OF_FRAMES):
+        message = random.choice(database.messages)
+        frame_ids.append(message.frame_id)
+        payloads.append(bytes(random.getrandbits(8)
+                              for _ in range(message.length)))
+
+    frames = list(zip(frame_ids, payloads))
+
+    def decode_message():
+        for frame_id, payload in frames:
+            database.decode_message(frame_id, payload, decode_choices=False)
+
+    def decode_frames():
+        database.decode_frames(frame_ids, payloads)
+
+    print('vehicle.dbc ({} frames):'.format(NUMBER_OF_FRAMES))
+    print('  decode_message: {:.3f} s'.format(measure(decode_message)))
+    print('  decode_frames:  {:.3f} s'.format(measure(decode_frames)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+#
+# Benchmark replaying one million frames of a message into a
+# dictionary each, a named tuple each, or the same record, and the
+# memory traced by tracemalloc when keeping the decoded frames of a
+# shorter replay.
+#
+# > python3 decode_records.py
+# ExampleMessage (1000000 frames):
+#   dict:        2.401 s, 240 bytes per kept frame
+#   as_tuple:    2.818 s, 128 bytes per kept frame
+#   decode_into: 1.919 s
+#
+
+import os
+import sys
+import tracemalloc
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import dbc_path
+from utils import measure
+
+import cantools
+
+
+NUMBER_OF_FRAMES = 1000000
+NUMBER_OF_KEPT_FRAMES = 100000
+
+
+def kept(decode, frames):
+    tracemalloc.start()
+    start, _ = tracemalloc.get_traced_memory()
+    decoded = [decode(data) for data in frames]
+    current, _ = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+
+    return (current - start) / len(decoded)
+
+
+def main():
+    database = cantools.database.load_file(dbc_path('motohawk.dbc'))
+    message = database.get_message_by_name('ExampleMessage')
+    frames = [
+        message.encode({
+            'Enable': i % 2,
+            'AverageRadius': (i % 50) / 10,
+            'Temperature': 250 + (i % 100) / 100
+        })
+        for i in range(1000)
+    ]
+    frames *= NUMBER_OF_FRAMES // len(frames)
+    record = message.record_type()
+
+    def as_dict(data):
+        return message.decode(data)
+
+    def as_tuple(data):
+        return message.decode(data, as_tuple=True)
+
+    def replay(decode):
+        def function():
+            for data in frames:
+                decode(data)
+
+        return function
+
+    def replay_into():
+        for data in frames:
+            message.decode_into(record, data)
+
+    print('{} ({} frames):'.format(message.name, len(frames)))
+    print('  dict:        {:.3f} s, {:.0f} bytes per kept frame'.format(
+        measure(replay(as_dict)),
+        kept(as_dict, frames[:NUMBER_OF_KEPT_FRAMES])))
+    print('  as_tuple:    {:.3f} s, {:.0f} bytes per kept frame'.format(
+        measure(replay(as_tuple)),
+        kept(as_tuple, frames[:NUMBER_OF_KEPT_FRAMES])))
+    print('  decode_into: {:.3f} s'.format(measure(replay_into)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#
+# Benchmark C source code generation of synthetically scaled up
+# databases, serially and in parallel with one job per CPU. The output
+# below is from a machine with one CPU, so only jobs=1 is shown.
+#
+# > python3 generate_c_source.py
+# abs.dbc x 20 (360 messages):
+#   jobs=1: 0.552 s
+# vehicle.dbc x 15 (3255 messages):
+#   jobs=1: 3.302 s
+#
+
+import os
+import sys
+import multiprocessing
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from cantools.database.can.c_source import generate
+from cantools.database.can.c_source import camel_to_snake_case
+
+from utils import scaled_database
+from utils import measure
+
+
+def main():
+    jobs = multiprocessing.cpu_count()
+
+    for name, factor in [('abs.dbc', 20), ('vehicle.dbc', 15)]:
+        database = scaled_database(name, factor)
+        print('{} x {} ({} messages):'.format(name,
+                                              factor,
+                                              len(database.messages)))
+
+        for n in sorted({1, jobs}):
+            camel_to_snake_case.cache_clear()
+            elapsed = measure(lambda: generate(database,
+                                               'bench',
+                                               'bench.h',
+                                               'bench.c',
+                                               'bench_fuzzer.c',
+                                               jobs=n))
+            print('  jobs={}: {:.3f} s'.format(n, elapsed))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+#
+# Benchmark loading a database of about 3000 messages, with the codecs
+# of the messages created on first use, and with all of them created
+# by Database.precompile() when loaded. Also loading the same database
+# in the binary CDB format, and loading only ten of its messages.
+#
+# > python3 load.py
+# vehicle.dbc x 14 (3038 messages):
+#   load:            0.897 s
+#   load+precompile: 7.108 s
+#   load cdb:        0.187 s
+#   load 10 frames:  0.188 s
+#
+
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import scaled_database
+from utils import measure
+
+import cantools
+
+
+FACTOR = 14
+
+
+def main():
+    database = scaled_database('vehicle.dbc', FACTOR)
+    dbc_string = database.as_dbc_string()
+    cdb_bytes = database.as_cdb_string()
+
+    def load():
+        cantools.database.load_string(dbc_string, 'dbc')
+
+    def load_and_precompile():
+        cantools.database.load_string(dbc_string, 'dbc').precompile()
+
+    def load_cdb():
+        cantools.database.load_string(cdb_bytes, 'cdb')
+
+    def load_frame_ids():
+        cantools.database.load_string(dbc_string,
+                                      'dbc',
+                                      frame_ids=range(10))
+
+    print('vehicle.dbc x {} ({} messages):'.format(FACTOR,
+                                                   len(database.messages)))
+    print('  load:            {:.3f} s'.format(measure(load)))
+    print('  load+precompile: {:.3f} s'.format(measure(load_and_precompile)))
+    print('  load cdb:        {:.3f} s'.format(measure(load_cdb)))
+    print('  load 10 frames:  {:.3f} s'.format(measure(load_frame_ids)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+#
+# Benchmark loading system-4.2.arxml with an increasing number of
+# unrelated packages added, each with elements. Both parsing the XML
+# and loading the database from the parsed tree should grow linearly
+# with the file size. Also loading the file incrementally, which
+# should use about the same amount of memory for all sizes.
+#
+# > python3 load_arxml.py
+# system-4.2.arxml + 1000 packages (2.3 MB):
+#   parse:            0.095 s
+#   load:             0.040 s
+#   load file:        0.184 s
+#   peak memory:      12.7 MB
+#   peak memory file: 0.9 MB
+# system-4.2.arxml + 2000 packages (4.5 MB):
+#   parse:            0.319 s
+#   load:             0.139 s
+#   load file:        0.564 s
+#   peak memory:      25.3 MB
+#   peak memory file: 1.5 MB
+# system-4.2.arxml + 4000 packages (9.0 MB):
+#   parse:            0.713 s
+#   load:             0.246 s
+#   load file:        1.191 s
+#   peak memory:      50.4 MB
+#   peak memory file: 2.7 MB
+#
+
+import os
+import sys
+import tempfile
+import tracemalloc
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import SCRIPT_DIR
+from utils import measure
+
+from xml.etree import ElementTree
+
+import cantools
+from cantools.database.can.formats.arxml import SystemLoader
+
+
+ARXML_PATH = os.path.join(SCRIPT_DIR,
+                          '..',
+                          'tests',
+                          'files',
+                          'arxml',
+                          'system-4.2.arxml')
+ELEMENTS_PER_PACKAGE = 20
+
+
+def padded_arxml(string, number_of_packages):
+    """Returns given ARXML string with given number of packages added
+    first in the top level package list.
+
+    """
+
+    element = ('<ECU-INSTANCE><SHORT-NAME>Ecu{}</SHORT-NAME>'
+               '<SLEEP-MODE-SUPPORTED>false</SLEEP-MODE-SUPPORTED>'
+               '</ECU-INSTANCE>')
+    elements = ''.join([element.format(i)
+                        for i in range(ELEMENTS_PER_PACKAGE)])
+    packages = ''.join([
+        '<AR-PACKAGE><SHORT-NAME>Padding{}</SHORT-NAME>'
+        '<ELEMENTS>{}</ELEMENTS></AR-PACKAGE>'.format(i, elements)
+        for i in range(number_of_packages)
+    ])
+
+    return string.replace('<AR-PACKAGES>', '<AR-PACKAGES>' + packages, 1)
+
+
+def peak_memory(function):
+    """Return the peak memory usage in bytes of calling `function`.
+
+    """
+
+    tracemalloc.start()
+
+    try:
+        function()
+
+        return tracemalloc.get_traced_memory()[1]
+    finally:
+        tracemalloc.stop()
+
+
+def main():
+    with open(ARXML_PATH) as fin:
+        string = fin.read()
+
+    for number_of_packages in [1000, 2000, 4000]:
+        padded = padded_arxml(string, number_of_packages)
+
+        root = ElementTree.fromstring(padded)
+
+        def parse():
+            ElementTree.fromstring(padded)
+
+        def load():
+            SystemLoader(root, True).load()
+
+        print('system-4.2.arxml + {} packages ({:.1f} MB):'.format(
+            number_of_packages,
+            len(padded) / 1000000))
+        with tempfile.TemporaryDirectory() as directory:
+            filename = os.path.join(directory, 'padded.arxml')
+
+            with open(filename, 'w') as fout:
+                fout.write(padded)
+
+            def load_string():
+                cantools.database.load_string(padded, 'arxml')
+
+            def load_file():
+                cantools.database.load_file(filename)
+
+            print('  parse:            {:.3f} s'.format(measure(parse)))
+            print('  load:             {:.3f} s'.format(measure(load)))
+            print('  load file:        {:.3f} s'.format(measure(load_file)))
+            print('  peak memory:      {:.1f} MB'.format(
+                peak_memory(load_string) / 1000000))
+            print('  peak memory file: {:.1f} MB'.format(
+                peak_memory(load_file) / 1000000))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+#
+# Benchmark loading eight DBC files of about 650 messages each into
+# one database, with one to four worker processes. The load time
+# should decrease with the number of workers, up to the number of
+# CPUs. The output below is from a machine with one CPU, where the
+# worker processes only add overhead.
+#
+# > python3 load_files.py
+# 8 files (5208 messages):
+#   jobs=1: 1.604 s
+#   jobs=2: 4.598 s
+#   jobs=4: 4.179 s
+#
+
+import os
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import scaled_database
+from utils import measure
+
+import cantools
+
+
+NUMBER_OF_FILES = 8
+FACTOR = 3
+
+
+def main():
+    database = scaled_database('vehicle.dbc', FACTOR)
+    names = [message.name for message in database.messages]
+
+    with tempfile.TemporaryDirectory() as directory:
+        filenames = []
+
+        # Unique message names and frame ids in all files.
+        for i in range(NUMBER_OF_FILES):
+            for name, message in zip(names, database.messages):
+                message.name = '{}_{}'.format(name, i)
+                message.frame_id = (message.frame_id & 0xffff) | (i << 16)
+
+            filename = os.path.join(directory, 'bus{}.dbc'.format(i))
+            cantools.database.dump_file(database, filename)
+            filenames.append(filename)
+
+        print('{} files ({} messages):'.format(
+            NUMBER_OF_FILES,
+            NUMBER_OF_FILES * len(database.messages)))
+
+        for jobs in [1, 2, 4]:
+            def load():
+                cantools.database.load_files(filenames, jobs=jobs)
+
+            print('  jobs={}: {:.3f} s'.format(jobs, measure(load)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+#
+# Benchmark loading databases without giving their format, which is
+# then detected from the first characters of the file, compared to
+# trying one format after the other as done before format detection.
+#
+# > python3 load_sniff.py
+# the_homer.kcd:
+#   load sniffed: 0.077 s
+#   load trial:   0.106 s
+# jopp-6.0.sym:
+#   load sniffed: 0.032 s
+#   load trial:   0.031 s
+# vehicle.dbc:
+#   load sniffed: 0.474 s
+#   load trial:   0.471 s
+# example.cdd:
+#   load sniffed: 0.365 s
+#   load trial:   1.120 s
+#
+
+import os
+import sys
+import logging
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import SCRIPT_DIR
+from utils import measure
+
+import cantools
+from cantools.database import UnsupportedDatabaseFormatError
+
+
+FILENAMES = [
+    'kcd/the_homer.kcd',
+    'sym/jopp-6.0.sym',
+    'dbc/vehicle.dbc',
+    'cdd/example.cdd'
+]
+ITERATIONS = 10
+
+
+def load_trial(string):
+    """Load given string by trying each format in the order used before
+    format detection.
+
+    """
+
+    for database_format in ['arxml', 'dbc', 'kcd', 'sym', 'cdd']:
+        try:
+            return cantools.database.load_string(string, database_format)
+        except UnsupportedDatabaseFormatError:
+            pass
+
+    raise Exception('Failed to load string.')
+
+
+def main():
+    # Do not print the warnings about duplicated messages in the test
+    # files.
+    logging.getLogger('cantools').setLevel(logging.ERROR)
+
+    for filename in FILENAMES:
+        path = os.path.join(SCRIPT_DIR, '..', 'tests', 'files', filename)
+
+        with open(path, encoding='cp1252') as fin:
+            string = fin.read()
+
+        def load_sniffed():
+            cantools.database.load_string(string)
+
+        def load_trial_():
+            load_trial(string)
+
+        print('{}:'.format(os.path.basename(filename)))
+        print('  load sniffed: {:.3f} s'.format(
+            measure(load_sniffed, ITERATIONS)))
+        print('  load trial:   {:.3f} s'.format(
+            measure(load_trial_, ITERATIONS)))
+
+
+if __name__ == '__main__':
+    main()
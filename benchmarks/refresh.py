@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+#
+# Benchmark refreshing a database of about 5000 messages after
+# modifying one signal, after modifying all messages, and adding one
+# message to it from a DBC string.
+#
+# > python3 refresh.py
+# vehicle.dbc x 23 (4991 messages):
+#   refresh one modified:  3.116 ms
+#   refresh all modified:  88.870 ms
+#   add one message:       0.120 ms
+#
+
+import os
+import sys
+from itertools import count
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from utils import scaled_database
+from utils import measure
+
+import cantools
+
+
+FACTOR = 23
+
+MESSAGE_DBC = '''\
+VERSION ""
+
+BS_:
+
+BU_:
+
+BO_ {frame_id} Added{number}: 8 Vector__XXX
+ SG_ Signal : 0|8@1+ (1,0) [0|255] "" Vector__XXX
+'''
+
+
+def main():
+    database = scaled_database('vehicle.dbc', FACTOR)
+    signal = database.messages[0].signals[0]
+    numbers = count()
+
+    def refresh_one_modified():
+        signal.scale = signal.scale
+        database.refresh()
+
+    def refresh_all_modified():
+        for message in database.messages:
+            message.length = message.length
+
+        database.refresh()
+
+    def add_one_message():
+        number = next(numbers)
+        database.add_dbc_string(MESSAGE_DBC.format(frame_id=0x80010000 + number,
+                                                   number=number))
+
+    print('vehicle.dbc x {} ({} messages):'.format(FACTOR,
+                                                   len(database.messages)))
+    print('  refresh one modified:  {:.3f} ms'.format(
+        1000 * measure(refresh_one_modified, 10) / 10))
+    print('  refresh all modified:  {:.3f} ms'.format(
+        1000 * measure(refresh_all_modified)))
+    print('  add one message:       {:.3f} ms'.format(
+        1000 * measure(add_one_message, 10) / 10))
+
+
+if __name__ == '__main__':
+    main()
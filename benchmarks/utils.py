@@ -0,0 +1,66 @@
+# Helpers shared by the benchmarks.
+
+import os
+import time
+from copy import deepcopy
+
+import cantools
+
+
+SCRIPT_DIR = os.path.dirname(os.path.realpath(__file__))
+DBC_DIR = os.path.join(SCRIPT_DIR, '..', 'tests', 'files', 'dbc')
+
+
+def dbc_path(name):
+    return os.path.join(DBC_DIR, name)
+
+
+def load_dbc(name, **kwargs):
+    return cantools.database.load_file(dbc_path(name), **kwargs)
+
+
+def scaled_database(name, factor):
+    """Load given DBC file and return a database with its messages
+    repeated `factor` times, each copy with unique names and frame
+    ids.
+
+    """
+
+    database = load_dbc(name)
+    messages = []
+    frame_id = 0
+
+    for i in range(factor):
+        for message in database.messages:
+            message = deepcopy(message)
+            message.name = '{}__{}'.format(message.name, i)
+            message.frame_id = frame_id
+            message.is_extended_frame = True
+            messages.append(message)
+            frame_id += 1
+
+    return cantools.database.can.Database(messages,
+                                          nodes=database.nodes,
+                                          dbc_specifics=database.dbc)
+
+
+def measure(function, iterations=1):
+    """Return the best wall clock time in seconds of calling `function`
+    `iterations` times.
+
+    """
+
+    best = None
+
+    for _ in range(3):
+        start = time.perf_counter()
+
+        for _ in range(iterations):
+            function()
+
+        elapsed = time.perf_counter() - start
+
+        if best is None or elapsed < best:
+            best = elapsed
+
+    return best
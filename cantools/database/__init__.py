@@ -1,9 +1,17 @@
 import os
+import re
+import time
+import hashlib
+import logging
+from collections import namedtuple
+from concurrent.futures import ProcessPoolExecutor
 from xml.etree import ElementTree
 from .errors import ParseError
 from .errors import Error
 from ..compat import fopen
+from ..version import __version__
 from . import can
+from .can.formats.utils import MessageFilter
 from . import diagnostics
 import textparser
 import diskcache
@@ -12,6 +20,65 @@ import diskcache
 from .can import *
 
 
+LOGGER = logging.getLogger(__name__)
+
+# Read files in chunks of this size when hashing them.
+HASH_CHUNK_SIZE = 1024 * 1024
+
+
+class CacheStatistics(namedtuple('CacheStatistics',
+                                 [
+                                     'hits',
+                                     'misses',
+                                     'hit_time',
+                                     'miss_time'
+                                 ])):
+    """Database cache statistics returned by
+    :func:`~cantools.database.cache_statistics()`.
+
+    `hits` and `misses` are the number of databases loaded from and
+    added to the cache. `hit_time` and `miss_time` are the total
+    number of seconds spent in :func:`~cantools.database.load_file()`
+    for them.
+
+    """
+
+
+_cache_statistics = CacheStatistics(0, 0, 0.0, 0.0)
+
+
+def cache_statistics():
+    """Returns the :class:`~cantools.database.CacheStatistics` of all
+    calls to :func:`~cantools.database.load_file()` with a cache
+    directory in this process.
+
+    >>> db = cantools.database.load_file('foo.dbc', cache_dir='cache')
+    >>> cantools.database.cache_statistics()
+    CacheStatistics(hits=1, misses=0, hit_time=0.0021, miss_time=0.0)
+
+    """
+
+    return _cache_statistics
+
+
+def _update_cache_statistics(is_hit, start_time):
+    global _cache_statistics
+
+    elapsed_time = time.perf_counter() - start_time
+    hits, misses, hit_time, miss_time = _cache_statistics
+
+    if is_hit:
+        hits += 1
+        hit_time += elapsed_time
+    else:
+        misses += 1
+        miss_time += elapsed_time
+
+    _cache_statistics = CacheStatistics(hits, misses, hit_time, miss_time)
+
+    return elapsed_time
+
+
 class UnsupportedDatabaseFormatError(Error):
     """This exception is raised when
     :func:`~cantools.database.load_file()`,
@@ -21,7 +88,7 @@ class UnsupportedDatabaseFormatError(Error):
 
     """
 
-    def __init__(self, e_arxml, e_dbc, e_kcd, e_sym, e_cdd):
+    def __init__(self, e_arxml, e_dbc, e_kcd, e_sym, e_cdd, e_cdb=None):
         message = []
 
         if e_arxml is not None:
@@ -39,6 +106,9 @@ class UnsupportedDatabaseFormatError(Error):
         if e_cdd is not None:
             message.append('CDD: "{}"'.format(e_cdd))
 
+        if e_cdb is not None:
+            message.append('CDB: "{}"'.format(e_cdb))
+
         message = ', '.join(message)
 
         super(UnsupportedDatabaseFormatError, self).__init__(message)
@@ -48,6 +118,22 @@ class UnsupportedDatabaseFormatError(Error):
         self.e_kcd = e_kcd
         self.e_sym = e_sym
         self.e_cdd = e_cdd
+        self.e_cdb = e_cdb
+
+    def __reduce__(self):
+        # Reraised from load_files() worker processes. The errors are
+        # passed as strings, as they may not be picklable.
+        errors = [
+            None if e is None else str(e)
+            for e in [self.e_arxml,
+                      self.e_dbc,
+                      self.e_kcd,
+                      self.e_sym,
+                      self.e_cdd,
+                      self.e_cdb]
+        ]
+
+        return (type(self), tuple(errors))
 
 
 def _resolve_database_format_and_encoding(database_format,
@@ -68,28 +154,139 @@ def _resolve_database_format_and_encoding(database_format,
     return database_format, encoding
 
 
+def _is_cdb(string):
+    return (isinstance(string, (bytes, bytearray))
+            and string.startswith(can.formats.cdb.MAGIC))
+
+
+# Exceptions raised by each database format if given string could not
+# be loaded.
+LOAD_STRING_ERRORS = {
+    'arxml': (ElementTree.ParseError, ValueError),
+    'dbc': textparser.ParseError,
+    'kcd': (ElementTree.ParseError, ValueError),
+    'sym': ParseError,
+    'cdd': (ElementTree.ParseError, ValueError)
+}
+
+# Number of characters at the start of a database string used to
+# detect its format.
+SNIFF_SIZE = 4096
+
+# XML declaration, comments and document type declaration followed by
+# the root element tag.
+_XML_ROOT_TAG_RE = re.compile(
+    r'\ufeff?(?:\s+|<\?.*?\?>|<!--.*?-->|<!DOCTYPE[^>]*>)*<([\w.:-]+)',
+    re.DOTALL)
+_XML_ROOT_TAG_FORMATS = {
+    'AUTOSAR': 'arxml',
+    'NetworkDefinition': 'kcd',
+    'CANDELA': 'cdd'
+}
+_DBC_KEYWORD_RE = re.compile(
+    r'\ufeff?(?:\s+|//[^\n]*\n)*'
+    r'(VERSION|NS_|BS_|BU_|BO_|CM_|BA_DEF_|BA_|VAL_TABLE_|VAL_)(?!\w)')
+_SYM_FORMAT_VERSION_RE = re.compile(r'^FormatVersion\s*=', re.MULTILINE)
+
+
+def _sniff_database_format(string):
+    """Returns the database format of given string based on its first
+    characters, or ``None`` if it could not be determined.
+
+    """
+
+    if not isinstance(string, str):
+        return None
+
+    head = string[:SNIFF_SIZE]
+    mo = _XML_ROOT_TAG_RE.match(head)
+
+    if mo is not None:
+        return _XML_ROOT_TAG_FORMATS.get(mo.group(1).rpartition(':')[2])
+
+    if _DBC_KEYWORD_RE.match(head):
+        return 'dbc'
+
+    if _SYM_FORMAT_VERSION_RE.search(head):
+        return 'sym'
+
+    return None
+
+
+def _hash_file(filename):
+    file_hash = hashlib.blake2b(digest_size=32)
+
+    with open(filename, 'rb') as fin:
+        while True:
+            chunk = fin.read(HASH_CHUNK_SIZE)
+
+            if not chunk:
+                break
+
+            file_hash.update(chunk)
+
+    return file_hash.hexdigest()
+
+
 def _load_file_cache(filename,
                      database_format,
                      encoding,
                      frame_id_mask,
                      strict,
-                     cache_dir):
-    with open(filename, 'rb') as fin:
-        key = fin.read()
-
-    cache = diskcache.Cache(cache_dir)
+                     message_filter,
+                     cache_dir,
+                     cache_check_mtime):
+    start_time = time.perf_counter()
+    options = (__version__,
+               database_format,
+               encoding,
+               frame_id_mask,
+               strict,
+               message_filter.as_key())
+
+    with diskcache.Cache(cache_dir) as cache:
+        # The hash of the file contents is cached by path, size and
+        # modification time so unmodified files are not read at all.
+        if cache_check_mtime:
+            stat = os.stat(filename)
+            stat_key = ('stat',
+                        os.path.abspath(filename),
+                        stat.st_size,
+                        stat.st_mtime_ns)
+            digest = cache.get(stat_key)
+        else:
+            digest = None
+
+        if digest is None:
+            digest = _hash_file(filename)
+
+            if cache_check_mtime:
+                cache[stat_key] = digest
+
+        key = ('database', digest) + options
+        database = cache.get(key)
+
+        if database is not None:
+            LOGGER.debug("Loaded '%s' from the cache in %.3f s.",
+                         filename,
+                         _update_cache_statistics(True, start_time))
+
+            return database
 
-    try:
-        return cache[key]
-    except KeyError:
         with fopen(filename, 'r', encoding=encoding) as fin:
-            database = load(fin,
-                            database_format,
-                            frame_id_mask,
-                            strict)
+            database = _load(fin,
+                             database_format,
+                             frame_id_mask,
+                             strict,
+                             message_filter)
+
         cache[key] = database
 
-        return database
+    LOGGER.debug("Loaded '%s' and added it to the cache in %.3f s.",
+                 filename,
+                 _update_cache_statistics(False, start_time))
+
+    return database
 
 
 def load_file(filename,
@@ -97,16 +294,20 @@ def load_file(filename,
               encoding=None,
               frame_id_mask=None,
               strict=True,
-              cache_dir=None):
+              cache_dir=None,
+              cache_check_mtime=True,
+              buses=None,
+              nodes=None,
+              frame_ids=None):
     """Open, read and parse given database file and return a
     :class:`can.Database<.can.Database>` or
     :class:`diagnostics.Database<.diagnostics.Database>` object with
     its contents.
 
     `database_format` is one of ``'arxml'``, ``'dbc'``, ``'kcd'``,
-    ``'sym'``, ``cdd`` and ``None``. If ``None``, the database format
-    is selected based on the filename extension as in the table below.
-    Filename extensions are case insensitive.
+    ``'sym'``, ``cdd``, ``'cdb'`` and ``None``. If ``None``, the
+    database format is selected based on the filename extension as in
+    the table below. Filename extensions are case insensitive.
 
     +-----------+-----------------+
     | Extension | Database format |
@@ -121,13 +322,16 @@ def load_file(filename,
     +-----------+-----------------+
     | .cdd      | ``'cdd'``       |
     +-----------+-----------------+
+    | .cdb      | ``'cdb'``       |
+    +-----------+-----------------+
     | <unknown> | ``None``        |
     +-----------+-----------------+
 
     `encoding` specifies the file encoding. If ``None``, the encoding
     is selected based on the database format as in the table
     below. Use ``open()`` and :func:`~cantools.database.load()` if
-    platform dependent encoding is desired.
+    platform dependent encoding is desired. CDB files are binary and
+    have no encoding.
 
     +-----------------+-------------------+
     | Database format | Default encoding  |
@@ -147,11 +351,22 @@ def load_file(filename,
 
     `cache_dir` specifies the database cache location in the file
     system. Give as ``None`` to disable the cache. By default the
-    cache is disabled. The cache key is the contents of given
-    file. Using a cache will significantly reduce the load time when
-    reloading the same file. The cache directory is automatically
-    created if it does not exist. Remove the cache directory
-    `cache_dir` to clear the cache.
+    cache is disabled. The cache key is a hash of the contents of
+    given file, the cantools version, `database_format`, `encoding`,
+    `frame_id_mask`, `strict`, `buses`, `nodes` and
+    `frame_ids`. Using a cache will significantly
+    reduce the load time when reloading the same file. The cache
+    directory is automatically created if it does not exist. Remove
+    the cache directory `cache_dir` to clear the cache. See
+    :func:`~cantools.database.cache_statistics()` for cache hit and
+    miss statistics.
+
+    If `cache_check_mtime` is ``True`` the hash of the file contents
+    is cached by the file's path, size and modification time, and the
+    file is not read at all if none of them has changed. Give as
+    ``False`` to hash the file contents on every load, for example if
+    the file may be modified without changing its size and
+    modification time.
 
     See :func:`~cantools.database.load_string()` for descriptions of
     other arguments.
@@ -171,20 +386,208 @@ def load_file(filename,
         database_format,
         encoding,
         filename)
+    message_filter = MessageFilter(buses, nodes, frame_ids)
+
+    if database_format == 'cdb':
+        with open(filename, 'rb') as fin:
+            return _load(fin,
+                         database_format,
+                         frame_id_mask,
+                         strict,
+                         message_filter)
 
     if cache_dir is None:
         with fopen(filename, 'r', encoding=encoding) as fin:
-            return load(fin,
-                        database_format,
-                        frame_id_mask,
-                        strict)
+            return _load(fin,
+                         database_format,
+                         frame_id_mask,
+                         strict,
+                         message_filter)
     else:
         return _load_file_cache(filename,
                                 database_format,
                                 encoding,
                                 frame_id_mask,
                                 strict,
-                                cache_dir)
+                                message_filter,
+                                cache_dir,
+                                cache_check_mtime)
+
+
+def _load_can_file(args):
+    filename, database_format, encoding, strict, message_filter = args
+    database_format, encoding = _resolve_database_format_and_encoding(
+        database_format,
+        encoding,
+        filename)
+
+    if database_format == 'cdb':
+        with open(filename, 'rb') as fin:
+            database = _load(fin,
+                             database_format,
+                             None,
+                             strict,
+                             message_filter)
+    else:
+        with fopen(filename, 'r', encoding=encoding) as fin:
+            database = _load(fin,
+                             database_format,
+                             None,
+                             strict,
+                             message_filter)
+
+    if not isinstance(database, can.Database):
+        raise ValueError(
+            "Only CAN databases can be loaded by load_files(), but '{}' is "
+            "not.".format(filename))
+
+    return database
+
+
+def _load_can_file_as_cdb(args):
+    """Load given file and return it in CDB format, which is much
+    faster to transfer between processes than database objects.
+
+    """
+
+    return _load_can_file(args).as_cdb_string()
+
+
+def _report_conflicts(filenames, databases, frame_id_mask):
+    """Log a warning for each message with the same name or masked frame
+    id as a message in another file.
+
+    """
+
+    name_to_filename = {}
+    frame_id_to_filename = {}
+
+    for filename, database in zip(filenames, databases):
+        names = set()
+        frame_ids = set()
+
+        for message in database.messages:
+            other = name_to_filename.get(message.name)
+
+            if other is not None:
+                LOGGER.warning("Message '%s' in '%s' has the same name as a "
+                               "message in '%s'.",
+                               message.name,
+                               filename,
+                               other)
+
+            masked_frame_id = (message.frame_id & frame_id_mask)
+            other = frame_id_to_filename.get(masked_frame_id)
+
+            if other is not None:
+                LOGGER.warning("Message '%s' in '%s' has the same masked "
+                               "frame id 0x%x as a message in '%s'.",
+                               message.name,
+                               filename,
+                               masked_frame_id,
+                               other)
+
+            names.add(message.name)
+            frame_ids.add(masked_frame_id)
+
+        for name in names:
+            name_to_filename.setdefault(name, filename)
+
+        for frame_id in frame_ids:
+            frame_id_to_filename.setdefault(frame_id, filename)
+
+
+def load_files(filenames,
+               database_format=None,
+               encoding=None,
+               frame_id_mask=None,
+               strict=True,
+               jobs=None,
+               buses=None,
+               nodes=None,
+               frame_ids=None):
+    """Open, read and parse given CAN database files in parallel and
+    return a :class:`can.Database<.can.Database>` object with the
+    contents of all of them.
+
+    `jobs` is the number of worker processes parsing the files, or
+    ``None`` to use one per CPU. Each worker sends the database it
+    has loaded back in CDB format. If `jobs` is 1, or if there is
+    only one file, the files are loaded in this process instead.
+
+    The messages of all files are merged in given order. A warning is
+    logged for each message with the same name or masked frame id as
+    a message in another file. Nodes with the same name are added
+    only once. The version and DBC specifics of the first file having
+    them are used.
+
+    See :func:`~cantools.database.load_file()` for descriptions of
+    other arguments.
+
+    >>> db = cantools.database.load_files(['foo.dbc', 'bar.arxml'])
+
+    """
+
+    message_filter = MessageFilter(buses, nodes, frame_ids)
+    args = [
+        (filename, database_format, encoding, strict, message_filter)
+        for filename in filenames
+    ]
+
+    if jobs is None:
+        jobs = os.cpu_count() or 1
+
+    if jobs == 1 or len(filenames) <= 1:
+        databases = [_load_can_file(arg) for arg in args]
+    else:
+        with ProcessPoolExecutor(max_workers=jobs) as executor:
+            datas = list(executor.map(_load_can_file_as_cdb, args))
+
+        databases = [
+            can.formats.cdb.load_string(data, strict) for data in datas
+        ]
+
+    if frame_id_mask is None:
+        frame_id_mask = 0xffffffff
+
+    _report_conflicts(filenames, databases, frame_id_mask)
+
+    messages = []
+    merged_nodes = []
+    node_names = set()
+    merged_buses = []
+    bus_names = set()
+    version = None
+    dbc_specifics = None
+
+    for database in databases:
+        messages += database.messages
+
+        for node in database.nodes:
+            if node.name not in node_names:
+                merged_nodes.append(node)
+                node_names.add(node.name)
+
+        for bus in database.buses:
+            if bus.name not in bus_names:
+                merged_buses.append(bus)
+                bus_names.add(bus.name)
+
+        if version is None:
+            version = database.version
+
+        if isinstance(database.dbc, can.formats.dbc.DbcSpecifics):
+            if dbc_specifics is None:
+                dbc_specifics = database.dbc
+
+    # Refreshed once, with all messages.
+    return can.Database(messages,
+                        merged_nodes,
+                        merged_buses,
+                        version,
+                        dbc_specifics,
+                        frame_id_mask,
+                        strict)
 
 
 def dump_file(database,
@@ -197,8 +600,9 @@ def dump_file(database,
     other arguments.
 
     The ``'dbc'`` database format will always have Windows-style line
-    endings (``\\r\\n``). For other database formats the line ending
-    depends on the operating system.
+    endings (``\\r\\n``). For other text database formats the line
+    ending depends on the operating system. The ``'cdb'`` database
+    format is binary, and is loaded much faster than the text formats.
 
     >>> db = cantools.database.load_file('foo.dbc')
     >>> cantools.database.dump_file(db, 'bar.dbc')
@@ -212,7 +616,12 @@ def dump_file(database,
 
     newline = None
 
-    if database_format == 'dbc':
+    if database_format == 'cdb':
+        with open(filename, 'wb') as fout:
+            fout.write(database.as_cdb_string())
+
+        return
+    elif database_format == 'dbc':
         output = database.as_dbc_string()
         newline = ''
     elif database_format == 'kcd':
@@ -228,7 +637,10 @@ def dump_file(database,
 def load(fp,
          database_format=None,
          frame_id_mask=None,
-         strict=True):
+         strict=True,
+         buses=None,
+         nodes=None,
+         frame_ids=None):
     """Read and parse given database file-like object and return a
     :class:`can.Database<.can.Database>` or
     :class:`diagnostics.Database<.diagnostics.Database>` object with
@@ -242,6 +654,12 @@ def load(fp,
     exception if given file-like object does not contain a supported
     database format.
 
+    A CDB file-like object must be opened in binary mode.
+
+    An ARXML file-like object is parsed incrementally if
+    `database_format` is ``'arxml'``, keeping only the parts needed
+    by the database in memory.
+
     >>> with open('foo.kcd') as fin:
     ...    db = cantools.database.load(fin)
     >>> db.version
@@ -249,28 +667,65 @@ def load(fp,
 
     """
 
-    return load_string(fp.read(),
-                       database_format,
-                       frame_id_mask,
-                       strict)
+    return _load(fp,
+                 database_format,
+                 frame_id_mask,
+                 strict,
+                 MessageFilter(buses, nodes, frame_ids))
+
+
+def _load(fp, database_format, frame_id_mask, strict, message_filter):
+    if database_format == 'arxml':
+        can.formats.arxml.check_message_filter(message_filter)
+        db = can.Database(frame_id_mask=frame_id_mask,
+                          strict=strict,
+                          message_filter=message_filter)
+
+        try:
+            db.add_arxml(fp)
+        except (ElementTree.ParseError, ValueError) as e:
+            raise UnsupportedDatabaseFormatError(e, None, None, None, None)
+
+        return db
+
+    return _load_string(fp.read(),
+                        database_format,
+                        frame_id_mask,
+                        strict,
+                        message_filter)
 
 
 def load_string(string,
                 database_format=None,
                 frame_id_mask=None,
-                strict=True):
+                strict=True,
+                buses=None,
+                nodes=None,
+                frame_ids=None):
     """Parse given database string and return a
     :class:`can.Database<.can.Database>` or
     :class:`diagnostics.Database<.diagnostics.Database>` object with
     its contents.
 
     `database_format` may be one of ``'arxml'``, ``'dbc'``, ``'kcd'``,
-    ``'sym'``, ``'cdd'`` or ``None``, where ``None`` means transparent
-    format.
+    ``'sym'``, ``'cdd'``, ``'cdb'`` or ``None``, where ``None`` means
+    transparent format. CDB data is given as bytes instead of a
+    string.
 
     See :class:`can.Database<.can.Database>` for a description of
     `strict`.
 
+    `buses`, `nodes` and `frame_ids` select the CAN messages to
+    load. Each is a list, or ``None`` to load messages regardless of
+    it. A message is loaded only if its bus name is in `buses`, if
+    any node in `nodes` sends it or receives any of its signals, and
+    if its frame id is in `frame_ids`. Messages not selected are
+    skipped while parsing, before their signals are checked and their
+    codecs are created. In ARXML files, the bus name is the short name
+    of the CAN cluster, and filtering by `nodes` raises a
+    :class:`ValueError`, as message senders and signal receivers are
+    not loaded. Diagnostics databases are not filtered.
+
     Raises an
     :class:`~cantools.database.UnsupportedDatabaseFormatError`
     exception if given string does not contain a supported database
@@ -283,20 +738,27 @@ def load_string(string,
 
     """
 
-    if database_format not in ['arxml', 'dbc', 'kcd', 'sym', 'cdd', None]:
-        raise ValueError(
-            "expected database format 'arxml', 'dbc', 'kcd', 'sym', 'cdd' or "
-            "None, but got '{}'".format(database_format))
+    return _load_string(string,
+                        database_format,
+                        frame_id_mask,
+                        strict,
+                        MessageFilter(buses, nodes, frame_ids))
+
 
-    e_arxml = None
-    e_dbc = None
-    e_kcd = None
-    e_sym = None
-    e_cdd = None
+def _load_string(string,
+                 database_format,
+                 frame_id_mask,
+                 strict,
+                 message_filter):
+    if database_format not in ['arxml', 'dbc', 'kcd', 'sym', 'cdd', 'cdb', None]:
+        raise ValueError(
+            "expected database format 'arxml', 'dbc', 'kcd', 'sym', 'cdd', "
+            "'cdb' or None, but got '{}'".format(database_format))
 
     def load_can_database(fmt):
         db = can.Database(frame_id_mask=frame_id_mask,
-                          strict=strict)
+                          strict=strict,
+                          message_filter=message_filter)
 
         if fmt == 'arxml':
             db.add_arxml_string(string)
@@ -306,39 +768,54 @@ def load_string(string,
             db.add_kcd_string(string)
         elif fmt == 'sym':
             db.add_sym_string(string)
+        elif fmt == 'cdb':
+            db.add_cdb_string(string)
 
         return db
 
-    if database_format in ['arxml', None]:
+    if database_format == 'cdb' or _is_cdb(string):
         try:
-            return load_can_database('arxml')
-        except (ElementTree.ParseError, ValueError) as e:
-            e_arxml = e
+            return load_can_database('cdb')
+        except ParseError as e:
+            raise UnsupportedDatabaseFormatError(None,
+                                                 None,
+                                                 None,
+                                                 None,
+                                                 None,
+                                                 e)
 
-    if database_format in ['dbc', None]:
-        try:
-            return load_can_database('dbc')
-        except textparser.ParseError as e:
-            e_dbc = e
+    if database_format is None:
+        database_formats = ['arxml', 'dbc', 'kcd', 'sym', 'cdd']
+        sniffed_database_format = _sniff_database_format(string)
+
+        # Try the sniffed format first, and the others only if it
+        # fails to load.
+        if sniffed_database_format is not None:
+            database_formats.remove(sniffed_database_format)
+            database_formats.insert(0, sniffed_database_format)
+    else:
+        database_formats = [database_format]
 
-    if database_format in ['kcd', None]:
-        try:
-            return load_can_database('kcd')
-        except (ElementTree.ParseError, ValueError) as e:
-            e_kcd = e
+    # Reject filters not supported by ARXML files before parsing.
+    if database_formats[0] == 'arxml':
+        can.formats.arxml.check_message_filter(message_filter)
 
-    if database_format in ['sym', None]:
-        try:
-            return load_can_database('sym')
-        except ParseError as e:
-            e_sym = e
+    errors = {}
 
-    if database_format in ['cdd', None]:
+    for fmt in database_formats:
         try:
-            db = diagnostics.Database()
-            db.add_cdd_string(string)
-            return db
-        except (ElementTree.ParseError, ValueError) as e:
-            e_cdd = e
-
-    raise UnsupportedDatabaseFormatError(e_arxml, e_dbc, e_kcd, e_sym, e_cdd)
+            if fmt == 'cdd':
+                db = diagnostics.Database()
+                db.add_cdd_string(string)
+
+                return db
+            else:
+                return load_can_database(fmt)
+        except LOAD_STRING_ERRORS[fmt] as e:
+            errors[fmt] = e
+
+    raise UnsupportedDatabaseFormatError(errors.get('arxml'),
+                                         errors.get('dbc'),
+                                         errors.get('kcd'),
+                                         errors.get('sym'),
+                                         errors.get('cdd'))
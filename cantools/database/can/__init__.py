@@ -4,3 +4,6 @@ from .message import EncodeError
 from .message import DecodeError
 from .signal import Signal
 from .node import Node
+from .projection import Projection
+from .lazy import LazyDecodedMessage
+from .decode_cache import DecodeCache
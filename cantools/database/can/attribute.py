@@ -3,6 +3,11 @@ class Attribute(object):
 
     """
 
+    __slots__ = (
+        '_value',
+        '_definition'
+    )
+
     def __init__(self,
                  value,
                  definition):
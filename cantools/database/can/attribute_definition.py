@@ -4,6 +4,16 @@ class AttributeDefinition(object):
 
     """
 
+    __slots__ = (
+        '_name',
+        '_default_value',
+        '_kind',
+        '_type_name',
+        '_minimum',
+        '_maximum',
+        '_choices'
+    )
+
     def __init__(self,
                  name,
                  default_value=None,
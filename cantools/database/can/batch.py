@@ -0,0 +1,1100 @@
+# Decode many frames of the same message at once into NumPy arrays,
+# and encode many frames at once from columns of signal values.
+#
+# NumPy is imported on first use as it is an optional dependency.
+
+import math
+import operator
+import struct
+from itertools import repeat
+
+from .signal import NamedSignalValue
+from .python_source import FLOAT_FORMATS
+from .python_source import _divide
+from .python_source import _encode_decimal
+from .python_source import _fits
+from .python_source import _float_bound
+from .python_source import _node_mask
+from ..utils import is_scaled_int64
+from ..utils import start_bit
+from ..errors import DecodeError
+from ..errors import EncodeError
+
+
+def _import_numpy():
+    try:
+        import numpy
+    except ImportError:
+        raise ImportError(
+            'NumPy is required to decode in batches. Install it with '
+            '"pip install numpy".')
+
+    return numpy
+
+
+def _is_integer(value):
+    return (isinstance(value, int)
+            or (isinstance(value, float) and value.is_integer()))
+
+
+def _to_array(numpy, payloads, length):
+    """Returns given payloads as a two dimensional array of bytes with
+    one row per frame and `length` columns.
+
+    """
+
+    if isinstance(payloads, numpy.ndarray) and payloads.ndim == 2:
+        if payloads.shape[1] < length:
+            raise DecodeError(
+                'Expected at least {} bytes per frame, but got {}.'.format(
+                    length,
+                    payloads.shape[1]))
+
+        return numpy.ascontiguousarray(payloads[:, :length], numpy.uint8)
+
+    payloads = list(payloads)
+
+    # Fast path for payloads of the message length, often all of
+    # them.
+    if set(map(len, payloads)) == {length}:
+        try:
+            array = numpy.frombuffer(b''.join(payloads), numpy.uint8)
+
+            return array.reshape(len(payloads), length)
+        except TypeError:
+            pass
+
+    rows = []
+
+    for payload in payloads:
+        if len(payload) < length:
+            raise DecodeError(
+                'Expected at least {} bytes per frame, but got {}.'.format(
+                    length,
+                    len(payload)))
+
+        rows.append(bytes(payload[:length]))
+
+    array = numpy.frombuffer(b''.join(rows), numpy.uint8)
+
+    return array.reshape(len(rows), length)
+
+
+class _Words(object):
+    """64 bits words of byte windows of the frames, created on demand
+    and shared by all signals in the same window.
+
+    """
+
+    def __init__(self, numpy, data):
+        self._numpy = numpy
+        self._data = data
+        self._words = {}
+
+    def get(self, begin, end, byte_order):
+        key = (begin, end, byte_order)
+
+        if key not in self._words:
+            numpy = self._numpy
+            padded = numpy.zeros((len(self._data), 8), numpy.uint8)
+            padded[:, :end - begin] = self._data[:, begin:end]
+
+            if byte_order == 'big_endian':
+                dtype = '>u8'
+            else:
+                dtype = '<u8'
+
+            words = padded.view(dtype).reshape(len(self._data))
+            self._words[key] = words.astype(numpy.uint64)
+
+        return self._words[key]
+
+
+def _unpack_wide(numpy, data, signal):
+    """Unpack given signal not within a 64 bits window as Python
+    integers, one frame at a time.
+
+    """
+
+    mask = (1 << signal.length) - 1
+    values = numpy.empty(len(data), object)
+
+    for i, row in enumerate(data):
+        if signal.byte_order == 'big_endian':
+            shift = 8 * len(row) - start_bit(signal) - signal.length
+            value = (int.from_bytes(row.tobytes(), 'big') >> shift) & mask
+        else:
+            value = (int.from_bytes(row.tobytes(), 'little') >> signal.start) & mask
+
+        if signal.is_signed and value & (1 << (signal.length - 1)):
+            value -= (1 << signal.length)
+
+        values[i] = value
+
+    return values
+
+
+def _unpack(numpy, data, words, signal):
+    """Returns given signal's raw values in all frames.
+
+    """
+
+    if signal.byte_order == 'big_endian':
+        first = start_bit(signal)
+    else:
+        first = signal.start
+
+    begin = first // 8
+    end = (first + signal.length + 7) // 8
+
+    if end > data.shape[1]:
+        raise DecodeError(
+            'The signal {} does not fit in the message.'.format(signal.name))
+
+    if end - begin > 8 or signal.length > 64:
+        if signal.is_float:
+            raise DecodeError(
+                'The float signal {} is not within 8 bytes.'.format(
+                    signal.name))
+
+        return _unpack_wide(numpy, data, signal)
+
+    if signal.byte_order == 'big_endian':
+        shift = 64 - (first - 8 * begin) - signal.length
+    else:
+        shift = first - 8 * begin
+
+    values = words.get(begin, end, signal.byte_order) >> numpy.uint64(shift)
+
+    if signal.length < 64:
+        values &= numpy.uint64((1 << signal.length) - 1)
+
+    if signal.is_float:
+        if signal.length == 16:
+            values = values.astype(numpy.uint16).view(numpy.float16)
+        elif signal.length == 32:
+            values = values.astype(numpy.uint32).view(numpy.float32)
+        elif signal.length == 64:
+            values = values.view(numpy.float64)
+        else:
+            raise DecodeError(
+                'Float signal {} length {} is not 16, 32 or 64 bits.'.format(
+                    signal.name,
+                    signal.length))
+
+        # Signaling NaNs are converted as well.
+        with numpy.errstate(invalid='ignore'):
+            return values.astype(numpy.float64)
+    elif signal.is_signed:
+        values = values.view(numpy.int64)
+
+        if signal.length < 64:
+            sign = numpy.int64(1 << (signal.length - 1))
+            values = (values ^ sign) - sign
+
+    return values
+
+
+def _scale(numpy, signal, values):
+    """Scale given raw values the same way as
+    :meth:`Message.decode()<cantools.database.can.Message.decode()>`.
+
+    """
+
+    if signal.is_float \
+       or not _is_integer(signal.scale) \
+       or not _is_integer(signal.offset):
+        return signal.scale * values.astype(numpy.float64) + signal.offset
+
+    scale = int(signal.scale)
+    offset = int(signal.offset)
+
+    if scale == 1 and offset == 0:
+        return values
+
+    # Python integers if the scaled values may not fit in 64 bits.
+    if values.dtype == object or not is_scaled_int64(signal, scale, offset):
+        values = values.astype(object)
+    else:
+        values = values.astype(numpy.int64)
+
+    return values * scale + offset
+
+
+def _decode_node(numpy, node, data, rows, scaling, columns):
+    """Decode given codec node's signals in frames `rows` of `data`, and
+    recursively its selected multiplexer branches.
+
+    """
+
+    selected_data = data[rows]
+    words = _Words(numpy, selected_data)
+    decoded = {}
+
+    for signal in node['signals']:
+        values = _unpack(numpy, selected_data, words, signal)
+
+        if scaling:
+            values = _scale(numpy, signal, values)
+
+        decoded[signal.name] = values
+
+        if signal.name not in columns:
+            columns[signal.name] = (numpy.zeros(len(data), values.dtype),
+                                    numpy.zeros(len(data), bool))
+
+        column, valid = columns[signal.name]
+
+        if column.dtype != values.dtype:
+            column = column.astype(numpy.result_type(column, values))
+            columns[signal.name] = (column, valid)
+
+        column[rows] = values
+        valid[rows] = True
+
+    for signal_name, multiplexer in node['multiplexers'].items():
+        mux = decoded[signal_name]
+
+        for multiplexer_id, child in multiplexer.items():
+            selected = rows[mux == multiplexer_id]
+
+            if len(selected) > 0:
+                _decode_node(numpy, child, data, selected, scaling, columns)
+
+
+def frames_to_array(numpy, payloads):
+    """Returns given payloads of any lengths as a two dimensional array
+    of bytes, padded with zeros, and an array of the payload lengths.
+
+    """
+
+    payloads = list(payloads)
+    lengths = numpy.fromiter(map(len, payloads), numpy.int64, len(payloads))
+
+    if len(payloads) == 0:
+        return numpy.zeros((0, 0), numpy.uint8), lengths
+
+    width = int(lengths.max())
+
+    try:
+        joined = b''.join(payloads)
+    except TypeError:
+        joined = b''.join([bytes(payload) for payload in payloads])
+
+    flat = numpy.frombuffer(joined, numpy.uint8)
+
+    if (lengths == width).all():
+        return flat.reshape(len(payloads), width), lengths
+
+    # Scatter the payloads into zero padded rows.
+    offsets = numpy.cumsum(lengths) - lengths
+    columns = numpy.arange(width)
+    valid = columns < lengths[:, None]
+    array = numpy.zeros((len(payloads), width), numpy.uint8)
+    array[valid] = flat[(offsets[:, None] + columns)[valid]]
+
+    return array, lengths
+
+
+def decode_batch(codecs, length, payloads, scaling):
+    """Decode given payloads of given message codecs. Returns a dictionary
+    of signal name and NumPy array entries.
+
+    """
+
+    numpy = _import_numpy()
+    data = _to_array(numpy, payloads, length)
+    rows = numpy.arange(len(data))
+    columns = {}
+    _decode_node(numpy, codecs, data, rows, scaling, columns)
+    root = set(signal.name for signal in codecs['signals'])
+    decoded = {}
+
+    for name, (column, valid) in columns.items():
+        if name in root:
+            decoded[name] = column
+        else:
+            decoded[name] = numpy.ma.masked_array(column, mask=~valid)
+
+    return decoded
+
+
+class RowError(Exception):
+    """Raised by :func:`encode_batch()` for a row it does not encode. The
+    caller encodes the row alone to raise the proper error.
+
+    """
+
+    def __init__(self, row):
+        super(RowError, self).__init__(row)
+        self.row = row
+
+
+def _find_numpy():
+    try:
+        import numpy
+    except ImportError:
+        return None
+
+    return numpy
+
+
+def _choice_numbers(signal):
+    numbers = {}
+
+    # The first choice wins, as in Signal.choice_string_to_number().
+    if signal.choices:
+        for number, choice in signal.choices.items():
+            numbers.setdefault(str(choice), number)
+
+    return numbers
+
+
+def _raw_range(signal):
+    """Returns the smallest and largest raw values of given integer
+    signal.
+
+    """
+
+    if signal.is_signed:
+        minimum = -(1 << (signal.length - 1))
+
+        return minimum, -minimum - 1
+    else:
+        return 0, (1 << signal.length) - 1
+
+
+def _create_converter(signal, scaling, strict):
+    """Returns a function converting a value of given signal to its bits
+    as an unsigned integer the same way as :meth:`Message.encode()`.
+    The function raises an exception for all values the encoder does
+    not accept, but not necessarily the same exception.
+
+    """
+
+    numbers = _choice_numbers(signal)
+    scale = signal.scale
+    offset = signal.offset
+    lower = -math.inf
+    upper = math.inf
+
+    if scaling and strict:
+        if signal.minimum is not None:
+            lower = signal.minimum
+
+        if signal.maximum is not None:
+            upper = signal.maximum
+
+    if signal.is_float:
+        pack = struct.Struct(FLOAT_FORMATS[signal.length]).pack
+
+        def convert_float(value):
+            if isinstance(value, str):
+                raw = numbers[value]
+            elif not isinstance(value, (int, float)):
+                raise TypeError
+            elif scaling:
+                if value < lower or value > upper:
+                    raise ValueError
+
+                raw = (value - offset) / scale
+            else:
+                raw = value
+
+            return int.from_bytes(pack(raw), 'big')
+
+        return convert_float
+
+    minimum, maximum = _raw_range(signal)
+    mask = (1 << signal.length) - 1
+
+    if not scaling:
+        def convert_unscaled(value):
+            if type(value) is int:
+                raw = value
+            elif isinstance(value, str):
+                raw = numbers[value]
+            else:
+                raise TypeError
+
+            if not minimum <= raw <= maximum:
+                raise ValueError
+
+            return raw & mask
+
+        return convert_unscaled
+
+    bound = _float_bound(signal)
+
+    if _is_integer(scale) and _is_integer(offset):
+        integer_scale = int(scale)
+        integer_offset = int(offset)
+    else:
+        integer_scale = None
+        integer_offset = None
+
+    def convert(value):
+        if isinstance(value, float) \
+           or (type(value) is int and integer_scale is None):
+            if value < lower or value > upper:
+                raise ValueError
+
+            if -bound < value < bound:
+                quotient = (value - offset) / scale
+                raw = round(quotient)
+
+                if abs(quotient - raw) > 0.4999:
+                    raw = _encode_decimal(value, offset, scale)
+            else:
+                raw = _encode_decimal(value, offset, scale)
+        elif type(value) is int:
+            if value < lower or value > upper:
+                raise ValueError
+
+            if integer_scale == 1:
+                raw = value - integer_offset
+            else:
+                raw = _divide(value - integer_offset, integer_scale)
+        elif isinstance(value, str):
+            raw = numbers[value]
+        else:
+            raise TypeError
+
+        if not minimum <= raw <= maximum:
+            raise ValueError
+
+        return raw & mask
+
+    return convert
+
+
+def _convert_column(signal, values, scaling, strict):
+    """Returns the bits of given values of given signal as unsigned
+    integers, converted and validated a column at a time with
+    builtins, or ``None`` if the values must be converted one at a
+    time with :func:`_create_converter()`.
+
+    """
+
+    if signal.is_float:
+        return None
+
+    types = set(map(type, values))
+
+    if not types:
+        return []
+    elif types == {str}:
+        raws = list(map(_choice_numbers(signal).get, values))
+
+        if None in raws:
+            return None
+    elif types <= {int, float}:
+        if not scaling:
+            if types != {int}:
+                return None
+
+            raws = values
+        else:
+            try:
+                if not math.isfinite(math.fsum(values)):
+                    return None
+            except (OverflowError, ValueError):
+                return None
+
+            smallest = min(values)
+            largest = max(values)
+
+            if strict:
+                if signal.minimum is not None and smallest < signal.minimum:
+                    return None
+
+                if signal.maximum is not None and largest > signal.maximum:
+                    return None
+
+            scale = signal.scale
+            offset = signal.offset
+
+            if (types == {int}
+                and _is_integer(scale)
+                and _is_integer(offset)):
+                if int(scale) != 1:
+                    return None
+
+                raws = list(map(operator.sub, values, repeat(int(offset))))
+            else:
+                bound = _float_bound(signal)
+
+                if not -bound < smallest <= largest < bound:
+                    return None
+
+                quotients = list(map(operator.truediv,
+                                     map(operator.sub, values, repeat(offset)),
+                                     repeat(scale)))
+                raws = list(map(round, quotients))
+
+                if max(map(abs, map(operator.sub, quotients, raws))) > 0.4999:
+                    return None
+    else:
+        return None
+
+    minimum, maximum = _raw_range(signal)
+    smallest = min(raws)
+
+    if smallest < minimum or max(raws) > maximum:
+        return None
+
+    if smallest < 0:
+        raws = list(map(operator.and_, raws, repeat((1 << signal.length) - 1)))
+
+    return raws
+
+
+def _select_branches(signal, multiplexer, values, rows):
+    """Returns given rows grouped by the multiplexer branch their values
+    select, as :meth:`Message.encode()` does.
+
+    """
+
+    numbers = _choice_numbers(signal)
+    selected = {multiplexer_id: [] for multiplexer_id in multiplexer}
+
+    for row, mux in zip(rows, values):
+        if isinstance(mux, (str, NamedSignalValue)):
+            mux = numbers.get(str(mux))
+
+        try:
+            selected[mux].append(row)
+        except (KeyError, TypeError):
+            raise RowError(row)
+
+    return selected
+
+
+class _Payloads(object):
+    """Payloads being encoded as Python integers, one big endian and one
+    little endian integer per row.
+
+    """
+
+    def __init__(self, columns, count, length, scaling, padding, strict):
+        self.rows = range(count)
+        self._columns = columns
+        self._length = length
+        self._scaling = scaling
+        self._padding = padding
+        self._strict = strict
+        self._words = {
+            'big_endian': [0] * count,
+            'little_endian': [0] * count
+        }
+        self._used = [0] * count
+
+    def column(self, name, rows):
+        try:
+            column = self._columns[name]
+        except KeyError:
+            raise RowError(rows[0])
+
+        if rows is self.rows:
+            return column
+
+        return [column[row] for row in rows]
+
+    def encode_signal(self, signal, rows):
+        values = self.column(signal.name, rows)
+        bits = _convert_column(signal, values, self._scaling, self._strict)
+
+        if bits is None:
+            bits = self._convert(signal, values, rows)
+
+        if signal.byte_order == 'big_endian':
+            shift = 8 * self._length - start_bit(signal) - signal.length
+        else:
+            shift = signal.start
+
+        words = self._words[signal.byte_order]
+
+        if rows is self.rows:
+            if shift > 0:
+                bits = map(operator.lshift, bits, repeat(shift))
+
+            words[:] = map(operator.or_, words, bits)
+        else:
+            for row, value in zip(rows, bits):
+                words[row] |= (value << shift)
+
+    def _convert(self, signal, values, rows):
+        convert = _create_converter(signal, self._scaling, self._strict)
+
+        try:
+            return list(map(convert, values))
+        except Exception:
+            for row, value in zip(rows, values):
+                try:
+                    convert(value)
+                except Exception:
+                    raise RowError(row)
+
+            raise
+
+    def use(self, node, rows):
+        if self._padding:
+            mask = _node_mask(node, self._length)
+            used = self._used
+
+            for row in rows:
+                used[row] |= mask
+
+    def select(self, signal, multiplexer, rows):
+        values = self.column(signal.name, rows)
+
+        return _select_branches(signal, multiplexer, values, rows)
+
+    def join(self, join):
+        length = self._length
+        words = self._words['big_endian']
+
+        if any(self._words['little_endian']):
+            words = [
+                be | int.from_bytes(le.to_bytes(length, 'little'), 'big')
+                for be, le in zip(words, self._words['little_endian'])
+            ]
+
+        if self._padding:
+            unused = (1 << (8 * length)) - 1
+            words = [word | (unused & ~used)
+                     for word, used in zip(words, self._used)]
+
+        payloads = list(map(int.to_bytes, words, repeat(length), repeat('big')))
+
+        if join:
+            return b''.join(payloads)
+
+        return payloads
+
+
+class _ArrayPayloads(object):
+    """Payloads of at most 8 bytes being encoded with NumPy, one big
+    endian and one little endian 64 bits word per row.
+
+    """
+
+    def __init__(self, numpy, columns, count, length, scaling, padding, strict):
+        self._numpy = numpy
+        self._columns = columns
+        self._arrays = {}
+        self._count = count
+        self._length = length
+        self._scaling = scaling
+        self._padding = padding
+        self._strict = strict
+        self._be = numpy.zeros(count, numpy.uint64)
+        self._le = numpy.zeros(count, numpy.uint64)
+        self._used = numpy.zeros(count, numpy.uint64)
+        self.rows = numpy.arange(count)
+
+    def column(self, name, rows):
+        if name not in self._arrays:
+            try:
+                column = self._columns[name]
+            except KeyError:
+                raise RowError(rows[0])
+
+            array = self._numpy.asarray(column)
+
+            # Python integers too big to convert exactly to floats.
+            if (array.dtype.kind == 'f'
+                and not isinstance(column, self._numpy.ndarray)
+                and array.size > 0
+                and not (abs(array).max() < 2 ** 53)):
+                array = self._numpy.array(column, object)
+
+            self._arrays[name] = array
+
+        if rows is self.rows:
+            return self._arrays[name]
+
+        return self._arrays[name][rows]
+
+    def _fail(self, bad, rows):
+        if bad.any():
+            raise RowError(int(rows[bad.argmax()]))
+
+    def _check_range(self, signal, values, rows):
+        if self._scaling and self._strict:
+            if signal.minimum is not None:
+                self._fail(values < signal.minimum, rows)
+
+            if signal.maximum is not None:
+                self._fail(values > signal.maximum, rows)
+
+    def _pack_floats(self, signal, raws, rows):
+        numpy = self._numpy
+        dtype, bits = {
+            16: (numpy.float16, numpy.uint16),
+            32: (numpy.float32, numpy.uint32),
+            64: (numpy.float64, numpy.uint64)
+        }[signal.length]
+
+        with numpy.errstate(over='ignore'):
+            packed = raws.astype(dtype)
+
+        # Too big to pack, as struct.pack() raises an error for.
+        self._fail(numpy.isinf(packed) & numpy.isfinite(raws), rows)
+
+        return packed.view(bits).astype(numpy.uint64)
+
+    def _pack_integers(self, signal, raws, rows):
+        numpy = self._numpy
+
+        minimum, maximum = _raw_range(signal)
+        maximum = min(maximum, (1 << 63) - 1)
+
+        self._fail((raws < minimum) | (raws > maximum), rows)
+        bits = raws.view(numpy.uint64)
+
+        if signal.length < 64:
+            bits = bits & numpy.uint64((1 << signal.length) - 1)
+
+        return bits
+
+    def _divide(self, numerators, denominator):
+        """Integer division rounding half to even, as :func:`_divide()`.
+
+        """
+
+        if denominator < 0:
+            numerators = -numerators
+            denominator = -denominator
+
+        quotients, remainders = self._numpy.divmod(numerators, denominator)
+        quotients += ((2 * remainders > denominator)
+                      | ((2 * remainders == denominator) & (quotients & 1 == 1)))
+
+        return quotients
+
+    def _convert_python(self, signal, values, rows):
+        convert = _create_converter(signal, self._scaling, self._strict)
+        bits = self._numpy.empty(len(values), self._numpy.uint64)
+
+        for i, value in enumerate(values.tolist()):
+            try:
+                bits[i] = convert(value)
+            except Exception:
+                raise RowError(int(rows[i]))
+
+        return bits
+
+    def _convert_strings(self, signal, values, rows):
+        """Convert each unique string once, often choices.
+
+        """
+
+        numpy = self._numpy
+        uniques, inverse = numpy.unique(values, return_inverse=True)
+        convert = _create_converter(signal, self._scaling, self._strict)
+        bits = numpy.empty(len(uniques), numpy.uint64)
+
+        for i, value in enumerate(uniques.tolist()):
+            try:
+                bits[i] = convert(value)
+            except Exception:
+                self._fail(inverse == i, rows)
+
+        return bits[inverse]
+
+    def _convert_integers(self, signal, values, rows):
+        numpy = self._numpy
+        values = values.astype(numpy.int64)
+
+        if not self._scaling:
+            if signal.is_float:
+                return self._pack_floats(signal,
+                                         values.astype(numpy.float64),
+                                         rows)
+
+            return self._pack_integers(signal, values, rows)
+
+        self._check_range(signal, values, rows)
+
+        if (signal.is_float
+            or not _is_integer(signal.scale)
+            or not _is_integer(signal.offset)):
+            return self._convert_floats(signal,
+                                        values.astype(numpy.float64),
+                                        rows)
+
+        scale = int(signal.scale)
+        offset = int(signal.offset)
+
+        if not (abs(offset) < 2 ** 61 and abs(scale) < 2 ** 61):
+            return self._convert_python(signal, values.astype(object), rows)
+
+        raws = values - offset
+
+        if scale != 1:
+            raws = self._divide(raws, scale)
+
+        return self._pack_integers(signal, raws, rows)
+
+    def _convert_floats(self, signal, values, rows):
+        numpy = self._numpy
+
+        if not self._scaling:
+            if signal.is_float:
+                return self._pack_floats(signal, values, rows)
+
+            return self._convert_python(signal, values, rows)
+
+        self._check_range(signal, values, rows)
+
+        if signal.is_float:
+            return self._pack_floats(signal,
+                                     (values - signal.offset) / signal.scale,
+                                     rows)
+
+        bound = _float_bound(signal)
+
+        with numpy.errstate(invalid='ignore'):
+            quotients = (values - signal.offset) / signal.scale
+            raws = numpy.rint(quotients)
+            exact = ((-bound < values)
+                     & (values < bound)
+                     & (abs(quotients - raws) <= 0.4999))
+
+        # Values not exactly scaled with floats are scaled with
+        # decimals, one at a time.
+        inexact = numpy.flatnonzero(~exact)
+        raws[inexact] = 0
+        bits = self._pack_integers(signal, raws.astype(numpy.int64), rows)
+        convert = _create_converter(signal, True, False)
+
+        for i in inexact.tolist():
+            try:
+                bits[i] = convert(float(values[i]))
+            except Exception:
+                raise RowError(int(rows[i]))
+
+        return bits
+
+    def encode_signal(self, signal, rows):
+        numpy = self._numpy
+        values = self.column(signal.name, rows)
+        kind = values.dtype.kind
+
+        if (kind in 'iu'
+            and values.size > 0
+            and not (-2 ** 61 < int(values.min())
+                     and int(values.max()) < 2 ** 61)):
+            kind = 'O'
+
+        if kind in 'US':
+            bits = self._convert_strings(signal, values, rows)
+        elif kind in 'iu':
+            bits = self._convert_integers(signal, values, rows)
+        elif kind == 'f':
+            bits = self._convert_floats(signal,
+                                        values.astype(numpy.float64),
+                                        rows)
+        else:
+            bits = self._convert_python(signal, values, rows)
+
+        if signal.byte_order == 'big_endian':
+            words = self._be
+            shift = 64 - start_bit(signal) - signal.length
+        else:
+            words = self._le
+            shift = signal.start
+
+        if rows is self.rows:
+            words |= (bits << numpy.uint64(shift))
+        else:
+            words[rows] |= (bits << numpy.uint64(shift))
+
+    def use(self, node, rows):
+        if self._padding:
+            self._used[rows] |= self._numpy.uint64(_node_mask(node, 8))
+
+    def select(self, signal, multiplexer, rows):
+        numpy = self._numpy
+        values = self.column(signal.name, rows)
+
+        if values.dtype.kind not in 'iuf':
+            selected = _select_branches(signal,
+                                        multiplexer,
+                                        values.tolist(),
+                                        rows.tolist())
+
+            return {
+                multiplexer_id: numpy.array(branch_rows, numpy.int64)
+                for multiplexer_id, branch_rows in selected.items()
+            }
+
+        selected = {}
+        matched = numpy.zeros(len(rows), bool)
+
+        for multiplexer_id in multiplexer:
+            is_selected = (values == multiplexer_id)
+            selected[multiplexer_id] = rows[is_selected]
+            matched |= is_selected
+
+        self._fail(~matched, rows)
+
+        return selected
+
+    def join(self, join):
+        numpy = self._numpy
+        count = self._count
+        data = self._be.astype('>u8').view(numpy.uint8).reshape(count, 8)
+        data |= self._le.astype('<u8').view(numpy.uint8).reshape(count, 8)
+
+        if self._padding:
+            data |= ~self._used.astype('>u8').view(numpy.uint8).reshape(count, 8)
+
+        length = self._length
+        joined = numpy.ascontiguousarray(data[:, :length]).tobytes()
+
+        if join:
+            return joined
+
+        return [joined[i * length:(i + 1) * length] for i in range(count)]
+
+
+def _encode_node(payloads, node, rows):
+    """Encode given codec node's signals in rows `rows`, and recursively
+    the multiplexer branches selected in them.
+
+    """
+
+    if len(rows) == 0:
+        return
+
+    for signal in node['signals']:
+        payloads.encode_signal(signal, rows)
+
+    payloads.use(node, rows)
+
+    for signal in node['signals']:
+        if signal.name not in node['multiplexers']:
+            continue
+
+        multiplexer = node['multiplexers'][signal.name]
+        selected = payloads.select(signal, multiplexer, rows)
+
+        for multiplexer_id, child in multiplexer.items():
+            _encode_node(payloads, child, selected[multiplexer_id])
+
+
+def count_rows(columns):
+    """Returns the number of rows in given columns, which must all have
+    the same length.
+
+    """
+
+    lengths = {name: len(column) for name, column in columns.items()}
+
+    if len(set(lengths.values())) > 1:
+        raise EncodeError(
+            'Expected columns of equal lengths, but got {}.'.format(lengths))
+
+    return max(lengths.values(), default=0)
+
+
+def get_row(columns, row):
+    """Returns a dictionary of signal name and value entries of given
+    row, as given to :meth:`Message.encode()`.
+
+    """
+
+    values = {}
+
+    for name, column in columns.items():
+        value = column[row]
+
+        # NumPy scalars as Python objects.
+        if hasattr(value, 'item') and not isinstance(value, (int, str)):
+            value = value.item()
+
+        values[name] = value
+
+    return values
+
+
+def _encode_rows(codecs,
+                 length,
+                 columns,
+                 count,
+                 scaling,
+                 padding,
+                 strict,
+                 join,
+                 numpy):
+    if numpy is not None and length <= 8:
+        payloads = _ArrayPayloads(numpy,
+                                  columns,
+                                  count,
+                                  length,
+                                  scaling,
+                                  padding,
+                                  strict)
+    else:
+        payloads = _Payloads(columns, count, length, scaling, padding, strict)
+
+    _encode_node(payloads, codecs, payloads.rows)
+
+    return payloads.join(join)
+
+
+def encode_batch(codecs,
+                 length,
+                 columns,
+                 count,
+                 scaling,
+                 padding,
+                 strict,
+                 join,
+                 numpy=None):
+    """Encode given `count` rows of columns of signal values of given
+    message codecs, one payload per row. NumPy is used if given and
+    the message is at most 8 bytes.
+
+    Returns ``None`` if the message layout is not supported. Raises
+    :class:`RowError` for the first row that can not be encoded.
+
+    """
+
+    if not _fits(codecs, length):
+        return None
+
+    try:
+        return _encode_rows(codecs,
+                            length,
+                            columns,
+                            count,
+                            scaling,
+                            padding,
+                            strict,
+                            join,
+                            numpy)
+    except RowError as e:
+        row = e.row
+
+    # Signals are encoded one at a time, so an earlier row may fail
+    # in a later signal. Encode the rows before the failed one until
+    # they all succeed.
+    while row > 0:
+        try:
+            _encode_rows(codecs,
+                         length,
+                         {name: column[:row] for name, column in columns.items()},
+                         row,
+                         scaling,
+                         padding,
+                         strict,
+                         True,
+                         numpy)
+            break
+        except RowError as e:
+            row = e.row
+
+    raise RowError(row)
@@ -1,8 +1,12 @@
 import re
 import time
+import multiprocessing
 from decimal import Decimal
+from functools import lru_cache
 
 from ...version import __version__
+from ..utils import format_or
+from ..utils import is_scaled_int64
 
 
 HEADER_FMT = '''\
@@ -281,6 +285,416 @@ all:
 \tllvm-cov report ./$(EXE) -instr-profile=$(EXE).profdata
 
 '''
+PYTHON_EXTENSION_SOURCE_FMT = '''\
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018-2019 Erik Moqvist
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * This file was generated by cantools version {version} {date}.
+ *
+ * CPython extension module {module_name}, decoding messages with the
+ * generated unpack functions. Build it together with {source}, for
+ * example:
+ *
+ *   cc -O2 -shared -fPIC -I<python include dir> {source} \\\\
+ *       {python_source} -o {module_name}<extension suffix>
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <string.h>
+
+#include "{header}"
+
+{helpers}{decoders}
+static PyObject *decode_frame(unsigned long frame_id,
+                              const uint8_t *src_p,
+                              size_t size,
+                              int scaling,
+                              PyObject *choices_p)
+{{
+    PyObject *frame_id_p;
+
+    switch (frame_id) {{
+{cases}
+    default:
+        break;
+    }}
+
+    frame_id_p = PyLong_FromUnsignedLong(frame_id);
+
+    if (frame_id_p != NULL) {{
+        PyErr_SetObject(PyExc_KeyError, frame_id_p);
+        Py_DECREF(frame_id_p);
+    }}
+
+    return (NULL);
+}}
+
+static PyObject *none_to_null(PyObject *obj_p)
+{{
+    return ((obj_p == Py_None) ? NULL : obj_p);
+}}
+
+PyDoc_STRVAR(decode_doc,
+"decode(frame_id, data, scaling=True, choices=None)\\\\n"
+"\\\\n"
+"Decode given data as a message with given frame id and return a\\\\n"
+"dictionary of signal name-value entries. choices is a dictionary of\\\\n"
+"signal names and their choice dictionaries, used to convert raw\\\\n"
+"values to choices.");
+
+static PyObject *m_decode(PyObject *self_p, PyObject *args_p, PyObject *kwargs_p)
+{{
+    static char *kwlist[] = {{ "frame_id", "data", "scaling", "choices", NULL }};
+    unsigned long frame_id;
+    Py_buffer data;
+    int scaling;
+    PyObject *choices_p;
+    PyObject *decoded_p;
+
+    (void)self_p;
+
+    scaling = 1;
+    choices_p = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args_p,
+                                     kwargs_p,
+                                     "ky*|pO",
+                                     &kwlist[0],
+                                     &frame_id,
+                                     &data,
+                                     &scaling,
+                                     &choices_p)) {{
+        return (NULL);
+    }}
+
+    decoded_p = decode_frame(frame_id,
+                             (const uint8_t *)data.buf,
+                             (size_t)data.len,
+                             scaling,
+                             none_to_null(choices_p));
+    PyBuffer_Release(&data);
+
+    return (decoded_p);
+}}
+
+PyDoc_STRVAR(decode_batch_doc,
+"decode_batch(frames, scaling=True, choices=None)\\\\n"
+"\\\\n"
+"Decode given iterable of (frame_id, data) pairs and return a list of\\\\n"
+"decoded signal dictionaries. choices is a dictionary of frame ids\\\\n"
+"and their signal choice dictionaries, as given to decode().");
+
+static PyObject *m_decode_batch(PyObject *self_p,
+                                PyObject *args_p,
+                                PyObject *kwargs_p)
+{{
+    static char *kwlist[] = {{ "frames", "scaling", "choices", NULL }};
+    PyObject *frames_p;
+    int scaling;
+    PyObject *choices_p;
+    PyObject *iterator_p;
+    PyObject *frame_p;
+    PyObject *frame_choices_p;
+    PyObject *decoded_p;
+    PyObject *result_p;
+    unsigned long frame_id;
+    Py_buffer data;
+    int res;
+
+    (void)self_p;
+
+    scaling = 1;
+    choices_p = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args_p,
+                                     kwargs_p,
+                                     "O|pO",
+                                     &kwlist[0],
+                                     &frames_p,
+                                     &scaling,
+                                     &choices_p)) {{
+        return (NULL);
+    }}
+
+    choices_p = none_to_null(choices_p);
+    iterator_p = PyObject_GetIter(frames_p);
+
+    if (iterator_p == NULL) {{
+        return (NULL);
+    }}
+
+    result_p = PyList_New(0);
+
+    if (result_p == NULL) {{
+        Py_DECREF(iterator_p);
+
+        return (NULL);
+    }}
+
+    while ((frame_p = PyIter_Next(iterator_p)) != NULL) {{
+        if (!PyArg_ParseTuple(frame_p, "ky*", &frame_id, &data)) {{
+            Py_DECREF(frame_p);
+            goto error;
+        }}
+
+        frame_choices_p = NULL;
+
+        if (choices_p != NULL) {{
+            frame_choices_p = PyDict_GetItem(choices_p,
+                                             PyTuple_GET_ITEM(frame_p, 0));
+        }}
+
+        decoded_p = decode_frame(frame_id,
+                                 (const uint8_t *)data.buf,
+                                 (size_t)data.len,
+                                 scaling,
+                                 frame_choices_p);
+        PyBuffer_Release(&data);
+        Py_DECREF(frame_p);
+
+        if (decoded_p == NULL) {{
+            goto error;
+        }}
+
+        res = PyList_Append(result_p, decoded_p);
+        Py_DECREF(decoded_p);
+
+        if (res != 0) {{
+            goto error;
+        }}
+    }}
+
+    Py_DECREF(iterator_p);
+
+    if (PyErr_Occurred()) {{
+        Py_DECREF(result_p);
+
+        return (NULL);
+    }}
+
+    return (result_p);
+
+ error:
+    Py_DECREF(iterator_p);
+    Py_DECREF(result_p);
+
+    return (NULL);
+}}
+
+static PyMethodDef module_methods[] = {{
+    {{
+        "decode",
+        (PyCFunction)(void (*)(void))m_decode,
+        METH_VARARGS | METH_KEYWORDS,
+        decode_doc
+    }},
+    {{
+        "decode_batch",
+        (PyCFunction)(void (*)(void))m_decode_batch,
+        METH_VARARGS | METH_KEYWORDS,
+        decode_batch_doc
+    }},
+    {{ NULL, NULL, 0, NULL }}
+}};
+
+static struct PyModuleDef module = {{
+    PyModuleDef_HEAD_INIT,
+    "{module_name}",
+    "Decoders of the messages in database {database_name}.",
+    -1,
+    module_methods,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+}};
+
+PyMODINIT_FUNC PyInit_{module_name}(void)
+{{
+    PyObject *module_p;
+    PyObject *frame_ids_p;
+
+    module_p = PyModule_Create(&module);
+
+    if (module_p == NULL) {{
+        return (NULL);
+    }}
+
+    frame_ids_p = Py_BuildValue("{{{frame_ids_format}}}"{frame_ids_args});
+
+    if (PyModule_AddObject(module_p, "FRAME_IDS", frame_ids_p) != 0) {{
+        Py_XDECREF(frame_ids_p);
+        Py_DECREF(module_p);
+
+        return (NULL);
+    }}
+
+    return (module_p);
+}}
+'''
+
+PYTHON_EXTENSION_ADD_SIGNAL_HELPER = '''\
+/**
+ * Add given decoded signal value to given dictionary. The choice of
+ * the raw value is added instead if the signal has a choice
+ * dictionary in choices_p. Steals the references to raw_p and
+ * scaled_p.
+ */
+static int add_signal(PyObject *decoded_p,
+                      PyObject *choices_p,
+                      const char *name_p,
+                      PyObject *raw_p,
+                      PyObject *scaled_p)
+{
+    PyObject *signal_choices_p;
+    PyObject *value_p;
+    int res;
+
+    if ((raw_p == NULL) || (scaled_p == NULL)) {
+        Py_XDECREF(raw_p);
+        Py_XDECREF(scaled_p);
+
+        return (-1);
+    }
+
+    value_p = scaled_p;
+
+    if (choices_p != NULL) {
+        signal_choices_p = PyDict_GetItemString(choices_p, name_p);
+
+        if (signal_choices_p != NULL) {
+            value_p = PyDict_GetItem(signal_choices_p, raw_p);
+
+            if (value_p == NULL) {
+                value_p = scaled_p;
+            }
+        }
+    }
+
+    res = PyDict_SetItemString(decoded_p, name_p, value_p);
+    Py_DECREF(raw_p);
+    Py_DECREF(scaled_p);
+
+    return (res);
+}
+
+'''
+
+PYTHON_EXTENSION_SCALE_INTEGER_HELPER = '''\
+/**
+ * Returns scale * raw + offset calculated with Python integers, for
+ * values that may not fit in a long long.
+ */
+static PyObject *scale_integer(PyObject *raw_p,
+                               const char *scale_p,
+                               const char *offset_p)
+{
+    PyObject *scale_obj_p;
+    PyObject *offset_obj_p;
+    PyObject *product_p;
+    PyObject *res_p;
+
+    if (raw_p == NULL) {
+        return (NULL);
+    }
+
+    scale_obj_p = PyLong_FromString(scale_p, NULL, 10);
+    offset_obj_p = PyLong_FromString(offset_p, NULL, 10);
+    product_p = NULL;
+    res_p = NULL;
+
+    if ((scale_obj_p != NULL) && (offset_obj_p != NULL)) {
+        product_p = PyNumber_Multiply(scale_obj_p, raw_p);
+
+        if (product_p != NULL) {
+            res_p = PyNumber_Add(product_p, offset_obj_p);
+        }
+    }
+
+    Py_XDECREF(scale_obj_p);
+    Py_XDECREF(offset_obj_p);
+    Py_XDECREF(product_p);
+    Py_DECREF(raw_p);
+
+    return (res_p);
+}
+
+'''
+
+PYTHON_EXTENSION_UNPACK_ERROR_HELPER = '''\
+static int unpack_error(size_t size, size_t length)
+{
+    PyErr_Format(PyExc_ValueError,
+                 "expected at least %zu bytes, but got %zu",
+                 length,
+                 size);
+
+    return (-1);
+}
+'''
+
+PYTHON_EXTENSION_DECODER_FMT = '''
+static PyObject *decode_{message_name}(const uint8_t *src_p,
+                                      size_t size,
+                                      int scaling,
+                                      PyObject *choices_p)
+{{
+    struct {database_name}_{message_name}_t msg;
+    PyObject *decoded_p;
+
+{unused}\
+    memset(&msg, 0, sizeof(msg));
+
+    if ({database_name}_{message_name}_unpack(&msg, src_p, size) != 0) {{
+        unpack_error(size, {message_length});
+
+        return (NULL);
+    }}
+
+    decoded_p = PyDict_New();
+
+    if (decoded_p == NULL) {{
+        return (NULL);
+    }}
+{body}
+    return (decoded_p);
+{error}\
+}}
+'''
+
+PYTHON_EXTENSION_DECODER_ERROR = '''
+ error:
+    Py_DECREF(decoded_p);
+
+    return (NULL);
+'''
+
 
 TEST_FMT = '''
 static void test_{name}(
@@ -851,14 +1265,22 @@ class Message(object):
         self._message = message
         self.snake_name = camel_to_snake_case(self.name)
         self.signals = [Signal(signal)for signal in message.signals]
+        self._signal_by_name = {
+            signal.name: signal
+            for signal in reversed(self.signals)
+        }
 
     def __getattr__(self, name):
         return getattr(self._message, name)
 
     def get_signal_by_name(self, name):
-        for signal in self.signals:
-            if signal.name == name:
-                return signal
+        return self._signal_by_name.get(name)
+
+
+RE_NON_CANONICAL = re.compile(r'[^a-zA-Z0-9]')
+RE_CAMEL_WORD = re.compile(r'(.)([A-Z][a-z]+)')
+RE_UNDERSCORES = re.compile(r'(_+)')
+RE_CAMEL_BOUNDARY = re.compile(r'([a-z0-9])([A-Z])')
 
 
 def _canonical(value):
@@ -866,13 +1288,14 @@ def _canonical(value):
 
     """
 
-    return re.sub(r'[^a-zA-Z0-9]', '_', value)
+    return RE_NON_CANONICAL.sub('_', value)
 
 
+@lru_cache(maxsize=None)
 def camel_to_snake_case(value):
-    value = re.sub(r'(.)([A-Z][a-z]+)', r'\1_\2', value)
-    value = re.sub(r'(_+)', '_', value)
-    value = re.sub(r'([a-z0-9])([A-Z])', r'\1_\2', value).lower()
+    value = RE_CAMEL_WORD.sub(r'\1_\2', value)
+    value = RE_UNDERSCORES.sub('_', value)
+    value = RE_CAMEL_BOUNDARY.sub(r'\1_\2', value).lower()
     value = _canonical(value)
 
     return value
@@ -1450,216 +1873,312 @@ def _generate_structs(database_name, messages, bit_fields):
     return '\n'.join(structs)
 
 
-def _generate_declarations(database_name, messages, floating_point_numbers):
-    declarations = []
+def _generate_declaration(database_name, message, floating_point_numbers):
+    signal_declarations = []
 
-    for message in messages:
-        signal_declarations = []
+    for signal in message.signals:
+        signal_declaration = ''
 
-        for signal in message.signals:
-            signal_declaration = ''
+        if floating_point_numbers:
+            signal_declaration = SIGNAL_DECLARATION_ENCODE_DECODE_FMT.format(
+                database_name=database_name,
+                message_name=message.snake_name,
+                signal_name=signal.snake_name,
+                type_name=signal.type_name)
+
+            signal_declaration += SIGNAL_DECLARATION_CLAMP_FMT.format(
+                database_name=database_name,
+                message_name=message.snake_name,
+                signal_name=signal.snake_name)
+
+        signal_declaration += SIGNAL_DECLARATION_IS_IN_RANGE_FMT.format(
+            database_name=database_name,
+            message_name=message.snake_name,
+            signal_name=signal.snake_name,
+            type_name=signal.type_name)
+
+        signal_declarations.append(signal_declaration)
 
-            if floating_point_numbers:
-                signal_declaration = SIGNAL_DECLARATION_ENCODE_DECODE_FMT.format(
-                    database_name=database_name,
-                    message_name=message.snake_name,
-                    signal_name=signal.snake_name,
-                    type_name=signal.type_name)
+    declaration = DECLARATION_FMT.format(database_name=database_name,
+                                         database_message_name=message.name,
+                                         message_name=message.snake_name)
+
+    if len(signal_declarations) > 0:
+        declaration += '\n' + '\n'.join(signal_declarations)
+        sep = ",\n    "
+
+        message_params_ptrs = sep + sep.join(\
+            ["double *{}".format(sig.snake_name)\
+            for sig in message.signals])
+
+        message_params_decl = sep + sep.join(\
+            ["double {}".format(sig.snake_name)\
+            for sig in message.signals])
+    else:
+        message_params_ptrs = ""
+        message_params_decl = ""
+
+    declaration += '\n' + MESSAGE_WRAP_PACK_DECLARATION_FMT.format(
+        database_name=database_name,
+        message_name=message.snake_name,
+        database_message_name=message.name,
+        message_params_decl=message_params_decl)
+
+    declaration += '\n' + MESSAGE_WRAP_UNPACK_DECLARATION_FMT.format(
+        database_name=database_name,
+        message_name=message.snake_name,
+        database_message_name=message.name,
+        message_params_ptrs=message_params_ptrs)
+
+    return declaration
+
+
+def _generate_definition(database_name,
+                         message,
+                         floating_point_numbers,
+                         pack_helper_kinds,
+                         unpack_helper_kinds):
+    signal_definitions = []
+
+    for signal, (encode, decode), check in zip(message.signals,
+                                               _generate_encode_decode(message),
+                                               _generate_is_in_range(message)):
+        if check == 'true':
+            unused = '    (void)value;\n\n'
+        else:
+            unused = ''
 
-                signal_declaration += SIGNAL_DECLARATION_CLAMP_FMT.format(
-                    database_name=database_name,
-                    message_name=message.snake_name,
-                    signal_name=signal.snake_name)
+        signal_definition = ''
 
-            signal_declaration += SIGNAL_DECLARATION_IS_IN_RANGE_FMT.format(
+        if floating_point_numbers:
+            signal_definition = SIGNAL_DEFINITION_ENCODE_DECODE_FMT.format(
                 database_name=database_name,
                 message_name=message.snake_name,
                 signal_name=signal.snake_name,
-                type_name=signal.type_name)
+                type_name=signal.type_name,
+                encode=encode,
+                decode=decode)
 
-            signal_declarations.append(signal_declaration)
+            # 'signal.is_float' means something else!
+            if signal.minimum is not None:
+                if ('e' in str(signal.minimum)) or ('.' in str(signal.minimum)):
+                    suff = ""
+                else:
+                    suff = ".0"
 
-        declaration = DECLARATION_FMT.format(database_name=database_name,
-                                             database_message_name=message.name,
-                                             message_name=message.snake_name)
+                clamp_min = "    ret = CTOOLS_MAX(ret, {}{});" \
+                    .format(signal.minimum, suff)
+            else:
+                clamp_min = ""
 
-        if len(signal_declarations) > 0:
-            declaration += '\n' + '\n'.join(signal_declarations)
-            sep = ",\n    "
+            if signal.maximum is not None:
+                if ('e' in str(signal.maximum)) or ('.' in str(signal.maximum)):
+                    suff = ""
+                else:
+                    suff = ".0"
 
-            message_params_ptrs = sep + sep.join(\
-                ["double *{}".format(sig.snake_name)\
-                for sig in message.signals])
+                clamp_max = "    ret = CTOOLS_MIN(ret, {}{});" \
+                    .format(signal.maximum, suff)
+            else:
+                clamp_max = ""
 
-            message_params_decl = sep + sep.join(\
-                ["double {}".format(sig.snake_name)\
-                for sig in message.signals])
-        else:
-            message_params_ptrs = ""
-            message_params_decl = ""
+            signal_definition += SIGNAL_DEFINITION_CLAMP_FMT.format(
+                database_name=database_name,
+                message_name=message.snake_name,
+                signal_name=signal.snake_name,
+                clamp_max=clamp_max,
+                clamp_min=clamp_min)
 
-        declaration += '\n' + MESSAGE_WRAP_PACK_DECLARATION_FMT.format(
+        signal_definition += SIGNAL_DEFINITION_IS_IN_RANGE_FMT.format(
             database_name=database_name,
             message_name=message.snake_name,
-            database_message_name=message.name,
-            message_params_decl=message_params_decl)
+            signal_name=signal.snake_name,
+            type_name=signal.type_name,
+            unused=unused,
+            check=check)
+
+        signal_definitions.append(signal_definition)
+
+    if message.length > 0:
+        pack_variables, pack_body = _format_pack_code(message,
+                                                      pack_helper_kinds)
+        unpack_variables, unpack_body = _format_unpack_code(message,
+                                                            unpack_helper_kinds)
+        pack_unused = ''
+        unpack_unused = ''
+
+        if not pack_body:
+            pack_unused += '    (void)src_p;\n\n'
+
+        if not unpack_body:
+            unpack_unused += '    (void)dst_p;\n'
+            unpack_unused += '    (void)src_p;\n\n'
+
+        definition = DEFINITION_FMT.format(database_name=database_name,
+                                           database_message_name=message.name,
+                                           message_name=message.snake_name,
+                                           message_length=message.length,
+                                           pack_unused=pack_unused,
+                                           unpack_unused=unpack_unused,
+                                           pack_variables=pack_variables,
+                                           pack_body=pack_body,
+                                           unpack_variables=unpack_variables,
+                                           unpack_body=unpack_body)
+
+        message_params_decl = ""
+        message_params_ptrs = ""
+        params_encode = ""
+        range_checks = ""
+        signals_return = ""
+
+        sep = ',\n    '
+        for sig in message.signals:
+            message_params_decl += sep + "double {}".format(sig.snake_name)
+            message_params_ptrs += sep + "double *{}".format(sig.snake_name)
+
+            params_encode += "    msg.{sig} = {db}_{msg}_{sig}_encode({sig});\n".format(
+                db=database_name, msg=message.snake_name, sig=sig.snake_name)
+
+            range_checks += "\n    if (!{db}_{msg}_{sig}_is_in_range(msg->{sig}))\n".format(
+                db=database_name, msg=message.snake_name, sig=sig.snake_name)
+
+            range_checks += "        return idx;\n\n"
+            range_checks += "    idx++;\n"
+
+            signals_return += "\n    if ({sig})\n".format(sig=sig.snake_name)
+            signals_return += "        *{sig} = {db}_{msg}_{sig}_decode(msg.{sig});\n" \
+                .format(db=database_name, msg=message.snake_name, sig=sig.snake_name)
+
+        if len(message.signals) <= 0:
+            range_checks = "    (void)msg;\n"
+            range_checks += "    (void)idx;\n"
+
+        definition += '\n' + DEFINITION_WRAP_PACK_FMT.format(
+            database_name = database_name,
+            message_name = message.snake_name,
+            message_params_decl = message_params_decl,
+            range_checks = range_checks,
+            params_encode = params_encode,
+            message_length = message.length)
+
+        definition += '\n' + DEFINITION_WRAP_UNPACK_FMT.format(
+            database_name = database_name,
+            message_name = message.snake_name,
+            message_params_ptrs = message_params_ptrs,
+            signals_return = signals_return)
 
-        declaration += '\n' + MESSAGE_WRAP_UNPACK_DECLARATION_FMT.format(
-            database_name=database_name,
-            message_name=message.snake_name,
-            database_message_name=message.name,
-            message_params_ptrs=message_params_ptrs)
+    else:
+        definition = EMPTY_DEFINITION_FMT.format(database_name=database_name,
+                                                 message_name=message.snake_name)
 
-        declarations.append(declaration)
+    if signal_definitions:
+        definition += '\n' + '\n'.join(signal_definitions)
 
-    return '\n'.join(declarations)
+    return definition
 
 
-def _generate_definitions(database_name, messages, floating_point_numbers):
-    definitions = []
+# Database name, messages and floating point numbers flag of the
+# ongoing generation, inherited by forked worker processes.
+_WORKER_STATE = None
+
+
+def _generate_message(database_name, message, floating_point_numbers):
+    """Generate the declaration and definition of given message, and the
+    pack and unpack helper kinds it needs.
+
+    """
+
     pack_helper_kinds = set()
     unpack_helper_kinds = set()
+    declaration = _generate_declaration(database_name,
+                                        message,
+                                        floating_point_numbers)
+    definition = _generate_definition(database_name,
+                                      message,
+                                      floating_point_numbers,
+                                      pack_helper_kinds,
+                                      unpack_helper_kinds)
 
-    for message in messages:
-        signal_definitions = []
+    return declaration, definition, pack_helper_kinds, unpack_helper_kinds
 
-        for signal, (encode, decode), check in zip(message.signals,
-                                                   _generate_encode_decode(message),
-                                                   _generate_is_in_range(message)):
-            if check == 'true':
-                unused = '    (void)value;\n\n'
-            else:
-                unused = ''
-
-            signal_definition = ''
-
-            if floating_point_numbers:
-                signal_definition = SIGNAL_DEFINITION_ENCODE_DECODE_FMT.format(
-                    database_name=database_name,
-                    message_name=message.snake_name,
-                    signal_name=signal.snake_name,
-                    type_name=signal.type_name,
-                    encode=encode,
-                    decode=decode)
-
-                # 'signal.is_float' means something else!
-                if signal.minimum is not None:
-                    if ('e' in str(signal.minimum)) or ('.' in str(signal.minimum)):
-                        suff = ""
-                    else:
-                        suff = ".0"
-
-                    clamp_min = "    ret = CTOOLS_MAX(ret, {}{});" \
-                        .format(signal.minimum, suff)
-                else:
-                    clamp_min = ""
-
-                if signal.maximum is not None:
-                    if ('e' in str(signal.maximum)) or ('.' in str(signal.maximum)):
-                        suff = ""
-                    else:
-                        suff = ".0"
 
-                    clamp_max = "    ret = CTOOLS_MIN(ret, {}{});" \
-                        .format(signal.maximum, suff)
-                else:
-                    clamp_max = ""
+def _generate_message_worker(index):
+    database_name, messages, floating_point_numbers = _WORKER_STATE
 
-                signal_definition += SIGNAL_DEFINITION_CLAMP_FMT.format(
-                    database_name=database_name,
-                    message_name=message.snake_name,
-                    signal_name=signal.snake_name,
-                    clamp_max=clamp_max,
-                    clamp_min=clamp_min)
+    return _generate_message(database_name,
+                             messages[index],
+                             floating_point_numbers)
 
-            signal_definition += SIGNAL_DEFINITION_IS_IN_RANGE_FMT.format(
-                database_name=database_name,
-                message_name=message.snake_name,
-                signal_name=signal.snake_name,
-                type_name=signal.type_name,
-                unused=unused,
-                check=check)
 
-            signal_definitions.append(signal_definition)
+def _generate_messages_parallel(database_name,
+                                messages,
+                                floating_point_numbers,
+                                jobs):
+    """Generate all messages in `jobs` forked worker processes. Only
+    message indices are sent to the workers, as they inherit the
+    messages when forked. Returns ``None`` if forking is unavailable on
+    this platform.
 
-        if message.length > 0:
-            pack_variables, pack_body = _format_pack_code(message,
-                                                          pack_helper_kinds)
-            unpack_variables, unpack_body = _format_unpack_code(message,
-                                                                unpack_helper_kinds)
-            pack_unused = ''
-            unpack_unused = ''
+    """
 
-            if not pack_body:
-                pack_unused += '    (void)src_p;\n\n'
+    global _WORKER_STATE
 
-            if not unpack_body:
-                unpack_unused += '    (void)dst_p;\n'
-                unpack_unused += '    (void)src_p;\n\n'
+    try:
+        context = multiprocessing.get_context('fork')
+    except ValueError:
+        return None
 
-            definition = DEFINITION_FMT.format(database_name=database_name,
-                                               database_message_name=message.name,
-                                               message_name=message.snake_name,
-                                               message_length=message.length,
-                                               pack_unused=pack_unused,
-                                               unpack_unused=unpack_unused,
-                                               pack_variables=pack_variables,
-                                               pack_body=pack_body,
-                                               unpack_variables=unpack_variables,
-                                               unpack_body=unpack_body)
-
-            message_params_decl = ""
-            message_params_ptrs = ""
-            params_encode = ""
-            range_checks = ""
-            signals_return = ""
-
-            sep = ',\n    '
-            for sig in message.signals:
-                message_params_decl += sep + "double {}".format(sig.snake_name)
-                message_params_ptrs += sep + "double *{}".format(sig.snake_name)
-
-                params_encode += "    msg.{sig} = {db}_{msg}_{sig}_encode({sig});\n".format(
-                    db=database_name, msg=message.snake_name, sig=sig.snake_name)
-
-                range_checks += "\n    if (!{db}_{msg}_{sig}_is_in_range(msg->{sig}))\n".format(
-                    db=database_name, msg=message.snake_name, sig=sig.snake_name)
-
-                range_checks += "        return idx;\n\n"
-                range_checks += "    idx++;\n"
-
-                signals_return += "\n    if ({sig})\n".format(sig=sig.snake_name)
-                signals_return += "        *{sig} = {db}_{msg}_{sig}_decode(msg.{sig});\n" \
-                    .format(db=database_name, msg=message.snake_name, sig=sig.snake_name)
-
-            if len(message.signals) <= 0:
-                range_checks = "    (void)msg;\n"
-                range_checks += "    (void)idx;\n"
-
-            definition += '\n' + DEFINITION_WRAP_PACK_FMT.format(
-                database_name = database_name,
-                message_name = message.snake_name,
-                message_params_decl = message_params_decl,
-                range_checks = range_checks,
-                params_encode = params_encode,
-                message_length = message.length)
-
-            definition += '\n' + DEFINITION_WRAP_UNPACK_FMT.format(
-                database_name = database_name,
-                message_name = message.snake_name,
-                message_params_ptrs = message_params_ptrs,
-                signals_return = signals_return)
+    _WORKER_STATE = (database_name, messages, floating_point_numbers)
+    chunksize = max(1, len(messages) // (4 * jobs))
 
-        else:
-            definition = EMPTY_DEFINITION_FMT.format(database_name=database_name,
-                                                     message_name=message.snake_name)
+    try:
+        with context.Pool(jobs) as pool:
+            # map() returns the results in message order, which makes
+            # the output identical to a serial generation.
+            return pool.map(_generate_message_worker,
+                            range(len(messages)),
+                            chunksize)
+    finally:
+        _WORKER_STATE = None
+
+
+def _generate_declarations_and_definitions(database_name,
+                                           messages,
+                                           floating_point_numbers,
+                                           jobs):
+    results = None
+
+    if jobs is None:
+        jobs = 1
+    elif jobs <= 0:
+        jobs = multiprocessing.cpu_count()
+
+    if jobs > 1 and len(messages) > 1:
+        results = _generate_messages_parallel(database_name,
+                                              messages,
+                                              floating_point_numbers,
+                                              min(jobs, len(messages)))
+
+    if results is None:
+        results = [
+            _generate_message(database_name, message, floating_point_numbers)
+            for message in messages
+        ]
 
-        if signal_definitions:
-            definition += '\n' + '\n'.join(signal_definitions)
+    declarations = []
+    definitions = []
+    pack_helper_kinds = set()
+    unpack_helper_kinds = set()
 
+    for declaration, definition, pack_kinds, unpack_kinds in results:
+        declarations.append(declaration)
         definitions.append(definition)
+        pack_helper_kinds |= pack_kinds
+        unpack_helper_kinds |= unpack_kinds
 
-    return '\n'.join(definitions), (pack_helper_kinds, unpack_helper_kinds)
+    return ('\n'.join(declarations),
+            '\n'.join(definitions),
+            (pack_helper_kinds, unpack_helper_kinds))
 
 
 def _generate_helpers_kind(kinds, left_format, right_format):
@@ -1767,7 +2286,8 @@ def generate(database,
              source_name,
              fuzzer_source_name,
              floating_point_numbers=True,
-             bit_fields=False):
+             bit_fields=False,
+             jobs=None):
     """Generate C source code from given CAN database `database`.
 
     `database_name` is used as a prefix for all defines, data
@@ -1787,6 +2307,11 @@ def generate(database,
 
     Set `bit_fields` to ``True`` to generate bit fields in structs.
 
+    `jobs` is the number of processes used to generate the message
+    specific code. Give as ``None`` or ``1`` to generate in the
+    calling process, or ``0`` to use one process per CPU. The output
+    does not depend on the number of jobs.
+
     This function returns a tuple of the C header and source files as
     strings.
 
@@ -1806,12 +2331,11 @@ def generate(database,
         messages)
     choices_defines = _generate_choices_defines(database_name, messages)
     structs = _generate_structs(database_name, messages, bit_fields)
-    declarations = _generate_declarations(database_name,
-                                          messages,
-                                          floating_point_numbers)
-    definitions, helper_kinds = _generate_definitions(database_name,
-                                                      messages,
-                                                      floating_point_numbers)
+    declarations, definitions, helper_kinds = \
+        _generate_declarations_and_definitions(database_name,
+                                               messages,
+                                               floating_point_numbers,
+                                               jobs)
     helpers = _generate_helpers(helper_kinds)
     extended_impl = _generate_extended_impl(database_name, messages)
 
@@ -1842,3 +2366,217 @@ def generate(database,
         fuzzer_source_name)
 
     return header, source, fuzzer_source, fuzzer_makefile
+
+
+def _is_integer(value):
+    return isinstance(value, int) or (isinstance(value, float)
+                                      and value.is_integer())
+
+
+def _format_python_extension_signal(signal):
+    """Returns the C statement adding given signal to the decoded
+    dictionary. Values are scaled as in
+    :meth:`cantools.database.can.Message.decode()`.
+
+    """
+
+    member = 'msg.{}'.format(signal.snake_name)
+
+    if signal.is_float:
+        raw = 'PyFloat_FromDouble((double){})'.format(member)
+    elif signal.is_signed:
+        raw = 'PyLong_FromLongLong((long long){})'.format(member)
+    else:
+        raw = 'PyLong_FromUnsignedLongLong((unsigned long long){})'.format(
+            member)
+
+    scale = signal.scale
+    offset = signal.offset
+
+    if signal.is_float or not _is_integer(scale) or not _is_integer(offset):
+        scaled = 'PyFloat_FromDouble({} * (double){} + {})'.format(
+            repr(float(scale)),
+            member,
+            repr(float(offset)))
+    elif scale == 1 and offset == 0:
+        scaled = raw
+    elif is_scaled_int64(signal, int(scale), int(offset)):
+        scaled = 'PyLong_FromLongLong({}LL * (long long){} + {}LL)'.format(
+            int(scale),
+            member,
+            int(offset))
+    else:
+        scaled = 'scale_integer({}, "{}", "{}")'.format(raw,
+                                                        int(scale),
+                                                        int(offset))
+
+    return [
+        'if (add_signal(decoded_p,',
+        '               choices_p,',
+        '               "{}",'.format(signal.name),
+        '               {},'.format(raw),
+        '               scaling ? {} : {}) != 0) {{'.format(scaled, raw),
+        '    goto error;',
+        '}'
+    ]
+
+
+def _format_python_extension_level(message, signal_names):
+    """Format one level in a signal tree. Signals are added before
+    multiplexed signals, in the same order as they are decoded by
+    :meth:`cantools.database.can.Message.decode()`.
+
+    """
+
+    body_lines = []
+    muxes_lines = []
+
+    for signal_name in signal_names:
+        if isinstance(signal_name, dict):
+            signal_name, multiplexed_signals = list(signal_name.items())[0]
+            muxes_lines.append(
+                _format_python_extension_mux(message,
+                                             signal_name,
+                                             multiplexed_signals))
+
+        signal = message.get_signal_by_name(signal_name)
+        body_lines += _format_python_extension_signal(signal)
+
+    for mux_lines in muxes_lines:
+        body_lines += mux_lines
+
+    return body_lines
+
+
+def _format_python_extension_mux(message, signal_name, multiplexed_signals):
+    signal = message.get_signal_by_name(signal_name)
+    lines = ['switch (msg.{}) {{'.format(signal.snake_name)]
+
+    for multiplexer_id, signal_names in sorted(multiplexed_signals.items()):
+        lines.append('')
+        lines.append('case {}:'.format(multiplexer_id))
+        lines += [
+            '    ' + line
+            for line in _format_python_extension_level(message, signal_names)
+        ]
+        lines.append('    break;')
+
+    lines += [
+        '',
+        'default:',
+        '    PyErr_Format(PyExc_ValueError,',
+        '                 "expected multiplexer id {}, but got %lld",'.format(
+            format_or(list(multiplexed_signals))),
+        '                 (long long)msg.{});'.format(signal.snake_name),
+        '    goto error;',
+        '}'
+    ]
+
+    return lines
+
+
+def _generate_python_extension_decoder(database_name, message):
+    body_lines = _format_python_extension_level(message, message.signal_tree)
+
+    if body_lines:
+        unused = ''
+        body = '\n'.join(['']
+                         + [('    ' + line).rstrip() for line in body_lines]
+                         + [''])
+        error = PYTHON_EXTENSION_DECODER_ERROR
+    else:
+        unused = '    (void)scaling;\n    (void)choices_p;\n\n'
+        body = ''
+        error = ''
+
+    return PYTHON_EXTENSION_DECODER_FMT.format(database_name=database_name,
+                                               message_name=message.snake_name,
+                                               message_length=message.length,
+                                               unused=unused,
+                                               body=body,
+                                               error=error)
+
+
+def generate_python_extension(database,
+                              database_name,
+                              header_name,
+                              source_name,
+                              python_source_name,
+                              module_name):
+    """Generate the C source code of a CPython extension module named
+    `module_name` from given CAN database `database`. The module
+    decodes messages using the functions generated by
+    :func:`~cantools.database.can.c_source.generate()`, and must be
+    built and linked together with them.
+
+    `database_name`, `header_name` and `source_name` are the same as
+    given to :func:`~cantools.database.can.c_source.generate()`, and
+    `python_source_name` is the file name of the extension module C
+    source file.
+
+    The module has the functions ``decode(frame_id, data,
+    scaling=True, choices=None)`` and ``decode_batch(frames,
+    scaling=True, choices=None)``, and the dictionary ``FRAME_IDS``
+    of frame ids and message names. Use
+    :meth:`~cantools.database.can.Database.register_codec()` to
+    decode messages in a database with it.
+
+    This function returns the C source file as a string.
+
+    """
+
+    date = time.ctime()
+    messages_by_frame_id = {}
+
+    # Frame ids must be unique in the switch statement. Keep the
+    # last message, as the database frame id lookup does.
+    for message in database.messages:
+        messages_by_frame_id[message.frame_id] = Message(message)
+
+    messages = list(messages_by_frame_id.values())
+    decoders = []
+    cases = []
+
+    for message in messages:
+        decoders.append(_generate_python_extension_decoder(database_name,
+                                                           message))
+        cases.append(
+            '    case {}_{}_FRAME_ID:\n'
+            '        return (decode_{}(src_p, size, scaling, choices_p));\n'.format(
+                database_name.upper(),
+                message.snake_name.upper(),
+                message.snake_name))
+
+    decoders = ''.join(decoders)
+
+    helpers = [
+        helper
+        for name, helper in [
+                ('add_signal(', PYTHON_EXTENSION_ADD_SIGNAL_HELPER),
+                ('scale_integer(', PYTHON_EXTENSION_SCALE_INTEGER_HELPER),
+                ('unpack_error(', PYTHON_EXTENSION_UNPACK_ERROR_HELPER)
+        ]
+        if name in decoders
+    ]
+
+    frame_ids_format = ','.join(['ks'] * len(messages))
+    frame_ids_args = ''.join([
+        ',\n                                {}_{}_FRAME_ID, "{}"'.format(
+            database_name.upper(),
+            message.snake_name.upper(),
+            message.name)
+        for message in messages
+    ])
+
+    return PYTHON_EXTENSION_SOURCE_FMT.format(version=__version__,
+                                              date=date,
+                                              module_name=module_name,
+                                              database_name=database_name,
+                                              header=header_name,
+                                              source=source_name,
+                                              python_source=python_source_name,
+                                              helpers=''.join(helpers),
+                                              decoders=decoders,
+                                              cases='\n'.join(cases),
+                                              frame_ids_format=frame_ids_format,
+                                              frame_ids_args=frame_ids_args)
@@ -1,16 +1,73 @@
 import logging
 
 from .formats import arxml
+from .formats import cdb
 from .formats import dbc
 from .formats import kcd
 from .formats import sym
+from .formats.utils import ALL_MESSAGES
 from .internal_database import InternalDatabase
+from .memory import memory_report
+from .projection import Projection
+from ..errors import DecodeError
 from ...compat import fopen
 
 
 LOGGER = logging.getLogger(__name__)
 
 
+class _Messages(list):
+    """The messages list of a database. It counts its modifications, so
+    that the database knows if it has been modified since the last
+    refresh without comparing it to a copy.
+
+    """
+
+    __slots__ = ('modifications', )
+
+    def __init__(self, messages=()):
+        super(_Messages, self).__init__(messages)
+        self.modifications = 0
+
+    def __reduce__(self):
+        return (_restore_messages, (list(self), self.modifications))
+
+
+def _restore_messages(messages, modifications):
+    messages = _Messages(messages)
+    messages.modifications = modifications
+
+    return messages
+
+
+def _counting_modifications(name):
+    method = getattr(list, name)
+
+    def modify(self, *args, **kwargs):
+        self.modifications += 1
+
+        return method(self, *args, **kwargs)
+
+    modify.__name__ = name
+
+    return modify
+
+
+for _name in ['__setitem__',
+              '__delitem__',
+              '__iadd__',
+              '__imul__',
+              'append',
+              'extend',
+              'insert',
+              'pop',
+              'remove',
+              'clear',
+              'sort',
+              'reverse']:
+    setattr(_Messages, _name, _counting_modifications(_name))
+
+
 class Database(object):
     """This class contains all messages, signals and definitions of a CAN
     network.
@@ -23,6 +80,15 @@ class Database(object):
     If `strict` is ``True`` an exception is raised if any signals are
     overlapping or if they don't fit in their message.
 
+    `message_filter` selects the messages added by the ``add_*()``
+    methods. See :func:`load_file()<cantools.database.load_file()>`
+    for its criteria.
+
+    The database keeps its messages in a list of its own, a copy of
+    `messages`, unless `messages` is the :attr:`.messages` list of
+    another database. Add messages to :attr:`.messages`, not to the
+    list given here, before calling :meth:`.refresh()`.
+
     """
 
     def __init__(self,
@@ -32,12 +98,18 @@ class Database(object):
                  version=None,
                  dbc_specifics=None,
                  frame_id_mask=None,
-                 strict=True):
-        self._messages = messages if messages else []
+                 strict=True,
+                 message_filter=ALL_MESSAGES):
+        if isinstance(messages, _Messages):
+            self._messages = messages
+        else:
+            self._messages = _Messages(messages if messages else [])
+
         self._nodes = nodes if nodes else []
         self._buses = buses if buses else []
         self._name_to_message = {}
         self._frame_id_to_message = {}
+        self._refreshed_modifications = None
         self._version = version
         self._dbc = dbc_specifics
 
@@ -46,11 +118,15 @@ class Database(object):
 
         self._frame_id_mask = frame_id_mask
         self._strict = strict
+        self._message_filter = message_filter
         self.refresh()
 
     @property
     def messages(self):
-        """A list of messages in the database.
+        """A list of messages in the database. Modifications of it are
+        counted, so that :meth:`.refresh()` only rebuilds the lookup
+        tables if needed. See :class:`.Database` for how it relates
+        to the list given to the constructor.
 
         Use :meth:`.get_message_by_frame_id()` or
         :meth:`.get_message_by_name()` to find a message by its frame
@@ -102,11 +178,14 @@ class Database(object):
 
     def add_arxml(self, fp):
         """Read and parse ARXML data from given file-like object and add the
-        parsed data to the database.
+        parsed data to the database. The data is parsed incrementally,
+        and only the parts needed by the database are kept in memory.
 
         """
 
-        self.add_arxml_string(fp.read())
+        arxml.check_message_filter(self._message_filter)
+        database = arxml.load(fp, self._strict, self._message_filter)
+        self._add_arxml_database(database)
 
     def add_arxml_file(self, filename, encoding='utf-8'):
         """Open, read and parse ARXML data from given file and add the parsed
@@ -125,14 +204,54 @@ class Database(object):
 
         """
 
-        database = arxml.load_string(string, self._strict)
+        arxml.check_message_filter(self._message_filter)
+        database = arxml.load_string(string,
+                                     self._strict,
+                                     self._message_filter)
+        self._add_arxml_database(database)
 
-        self._messages += database.messages
+    def _add_arxml_database(self, database):
         self._nodes = database.nodes
         self._buses = database.buses
         self._version = database.version
         self._dbc = database.dbc
-        self.refresh()
+        self._add_messages(database.messages)
+
+    def add_cdb(self, fp):
+        """Read and parse CDB data from given binary file-like object and add
+        the parsed data to the database.
+
+        """
+
+        self.add_cdb_string(fp.read())
+
+    def add_cdb_file(self, filename):
+        """Open, read and parse CDB data from given file and add the parsed
+        data to the database.
+
+        >>> db = cantools.database.Database()
+        >>> db.add_cdb_file('foo.cdb')
+
+        """
+
+        with open(filename, 'rb') as fin:
+            self.add_cdb(fin)
+
+    def add_cdb_string(self, data):
+        """Parse given CDB data bytes and add the parsed data to the
+        database.
+
+        """
+
+        database = cdb.load_string(data,
+                                   self._strict,
+                                   self._message_filter)
+
+        self._nodes = database.nodes
+        self._buses = database.buses
+        self._version = database.version
+        self._dbc = database.dbc
+        self._add_messages(database.messages)
 
     def add_dbc(self, fp):
         """Read and parse DBC data from given file-like object and add the
@@ -170,14 +289,15 @@ class Database(object):
 
         """
 
-        database = dbc.load_string(string, self._strict)
+        database = dbc.load_string(string,
+                                   self._strict,
+                                   self._message_filter)
 
-        self._messages += database.messages
         self._nodes = database.nodes
         self._buses = database.buses
         self._version = database.version
         self._dbc = database.dbc
-        self.refresh()
+        self._add_messages(database.messages)
 
     def add_kcd(self, fp):
         """Read and parse KCD data from given file-like object and add the
@@ -204,14 +324,15 @@ class Database(object):
 
         """
 
-        database = kcd.load_string(string, self._strict)
+        database = kcd.load_string(string,
+                                   self._strict,
+                                   self._message_filter)
 
-        self._messages += database.messages
         self._nodes = database.nodes
         self._buses = database.buses
         self._version = database.version
         self._dbc = database.dbc
-        self.refresh()
+        self._add_messages(database.messages)
 
     def add_sym(self, fp):
         """Read and parse SYM data from given file-like object and add the
@@ -238,14 +359,15 @@ class Database(object):
 
         """
 
-        database = sym.load_string(string, self._strict)
+        database = sym.load_string(string,
+                                   self._strict,
+                                   self._message_filter)
 
-        self._messages += database.messages
         self._nodes = database.nodes
         self._buses = database.buses
         self._version = database.version
         self._dbc = database.dbc
-        self.refresh()
+        self._add_messages(database.messages)
 
     def _add_message(self, message):
         """Add given message to the database.
@@ -282,6 +404,18 @@ class Database(object):
                                                 self._version,
                                                 self._dbc))
 
+    def as_cdb_string(self):
+        """Return the database as bytes formatted as a CDB file, a compact
+        binary format loaded much faster than the text formats.
+
+        """
+
+        return cdb.dump_string(InternalDatabase(self._messages,
+                                                self._nodes,
+                                                self._buses,
+                                                self._version,
+                                                self._dbc))
+
     def as_kcd_string(self):
         """Return the database as a string formatted as a KCD file.
 
@@ -364,7 +498,8 @@ class Database(object):
                        frame_id_or_name,
                        data,
                        decode_choices=True,
-                       scaling=True):
+                       scaling=True,
+                       lazy=False):
         """Decode given signal data `data` as a message of given frame id or
         name `frame_id_or_name`. Returns a dictionary of signal
         name-value entries.
@@ -374,6 +509,9 @@ class Database(object):
 
         If `scaling` is ``False`` no scaling of signals is performed.
 
+        If `lazy` is ``True`` signals are decoded when first
+        accessed. See :meth:`Message.decode()<cantools.database.can.Message.decode()>`.
+
         >>> db.decode_message(158, b'\\x01\\x45\\x23\\x00\\x11')
         {'Bar': 1, 'Fum': 5.0}
         >>> db.decode_message('Foo', b'\\x01\\x45\\x23\\x00\\x11')
@@ -386,23 +524,249 @@ class Database(object):
         except KeyError:
             message = self._name_to_message[frame_id_or_name]
 
-        return message.decode(data, decode_choices, scaling)
+        return message.decode(data, decode_choices, scaling, lazy=lazy)
+
+    def enable_decode_cache(self, size=1):
+        """Enable the decode cache of all messages in the database. See
+        :meth:`Message.enable_decode_cache()<cantools.database.can.Message.enable_decode_cache()>`.
 
-    def refresh(self):
+        """
+
+        for message in self._messages:
+            message.enable_decode_cache(size)
+
+    def disable_decode_cache(self):
+        """Disable the decode cache of all messages in the database.
+
+        """
+
+        for message in self._messages:
+            message.disable_decode_cache()
+
+    def projection(self, signals):
+        """Returns a :class:`~cantools.database.can.Projection` decoding
+        only selected signals of the messages in this database.
+
+        `signals` is either an iterable of signal names, or a function
+        called with a message and a signal, returning ``True`` if the
+        signal is selected.
+
+        >>> projection = db.projection(['Bar'])
+        >>> projection.decode_message(158, b'\\x01\\x45\\x23\\x00\\x11')
+        {'Bar': 1}
+
+        """
+
+        return Projection(self, signals)
+
+    def decode_frames(self, frame_ids, payloads, timestamps=None, scaling=True):
+        """Decode given frames at once, grouped by message. Requires
+        NumPy.
+
+        `frame_ids` is a sequence of frame ids, and `payloads` a
+        sequence of bytes-like objects or a two dimensional NumPy array of
+        bytes, one per frame. Frames with unknown frame ids are
+        ignored.
+
+        Returns a dictionary of message name and ``(timestamps,
+        signals)`` entries, where `timestamps` is an array of the
+        message's frames' timestamps in `timestamps`, or their indexes
+        in `frame_ids` if `timestamps` is ``None``, and `signals` is
+        the dictionary of NumPy arrays returned by
+        :meth:`Message.decode_batch()<cantools.database.can.Message.decode_batch()>`.
+
+        If `scaling` is ``False`` no scaling of signals is performed.
+
+        """
+
+        from .batch import _import_numpy
+        from .batch import frames_to_array
+
+        numpy = _import_numpy()
+        frame_ids = numpy.asarray(frame_ids, numpy.int64)
+
+        if timestamps is None:
+            timestamps = numpy.arange(len(frame_ids))
+        else:
+            timestamps = numpy.asarray(timestamps)
+
+        if isinstance(payloads, numpy.ndarray):
+            lengths = numpy.full(len(payloads), payloads.shape[1])
+        else:
+            payloads, lengths = frames_to_array(numpy, payloads)
+
+        # Group the frames by masked frame id.
+        masked_frame_ids = frame_ids & self._frame_id_mask
+        order = numpy.argsort(masked_frame_ids, kind='stable')
+        unique_frame_ids, starts, counts = numpy.unique(
+            masked_frame_ids[order],
+            return_index=True,
+            return_counts=True)
+        decoded = {}
+
+        for frame_id, start, count in zip(unique_frame_ids, starts, counts):
+            try:
+                message = self._frame_id_to_message[int(frame_id)]
+            except KeyError:
+                continue
+
+            rows = order[start:start + count]
+            length = lengths[rows].min()
+
+            if length < message.length:
+                raise DecodeError(
+                    'Expected at least {} bytes per frame, but got {}.'.format(
+                        message.length,
+                        length))
+
+            decoded[message.name] = (
+                timestamps[rows],
+                message.decode_batch(payloads[rows], scaling))
+
+        return decoded
+
+    def register_codec(self, module):
+        """Decode messages with given compiled extension module `module`,
+        generated by ``cantools generate_c_source --python-extension``
+        and built by the user. Only messages with the same frame id and
+        name as in the module are decoded by it. Returns a list of the
+        messages decoded by the module.
+
+        Give `module` as ``None`` to decode all messages in Python
+        again.
+
+        >>> import motohawk_python
+        >>> db.register_codec(motohawk_python)
+        [message('ExampleMessage', 0x1f0, False, 8, {None: 'Example message used as template in MotoHawk models.'})]
+
+        """
+
+        registered = []
+
+        for message in self._messages:
+            if module is None:
+                message.codec_module = None
+            elif module.FRAME_IDS.get(message.frame_id) == message.name:
+                message.codec_module = module
+                registered.append(message)
+
+        return registered
+
+    def precompile(self):
+        """Create the codecs, and generate the decoders and encoders, of all
+        messages now instead of on first encode or decode of each
+        message. See :meth:`Message.precompile()
+        <cantools.database.can.Message.precompile()>`.
+
+        """
+
+        for message in self._messages:
+            message.precompile()
+
+    def refresh(self, force=False):
         """Refresh the internal database state.
 
         This method must be called after modifying any message in the
         database to refresh the internal lookup tables used when
         encoding and decoding messages.
 
+        Only messages modified since last refreshed, see
+        :meth:`Message.is_refresh_needed()
+        <cantools.database.can.Message.is_refresh_needed()>`, are
+        refreshed, and the lookup tables are only rebuilt if messages
+        have been added, removed, renamed or given new frame ids. The
+        decode caches of the other messages are cleared.
+
+        Modifications of mutable signal and message attributes in
+        place, for example appending to
+        :attr:`Signal.multiplexer_ids
+        <cantools.database.can.Signal.multiplexer_ids>`, are not
+        tracked. Set `force` to ``True`` to refresh all messages and
+        rebuild the lookup tables after such modifications.
+
         """
 
-        self._name_to_message = {}
-        self._frame_id_to_message = {}
+        refreshed_messages = []
 
         for message in self._messages:
-            message.refresh(self._strict)
-            self._add_message(message)
+            if force or message.is_refresh_needed(self._strict):
+                message.refresh(self._strict)
+                refreshed_messages.append(message)
+            elif message.decode_cache is not None:
+                message.decode_cache.clear()
+
+        if (force
+            or self._messages.modifications != self._refreshed_modifications
+            or not all([self._is_indexed(message)
+                        for message in refreshed_messages])):
+            self._name_to_message = {}
+            self._frame_id_to_message = {}
+
+            for message in self._messages:
+                self._add_message(message)
+
+            self._refreshed_modifications = self._messages.modifications
+
+    def _is_indexed(self, message):
+        masked_frame_id = (message.frame_id & self._frame_id_mask)
+
+        return (self._name_to_message.get(message.name) is message
+                and self._frame_id_to_message.get(masked_frame_id) is message)
+
+    def _add_messages(self, messages):
+        """Add given messages to the database. Only the added messages are
+        refreshed and indexed if the messages list has not been
+        modified since the last refresh, otherwise the whole database
+        is refreshed.
+
+        """
+
+        if self._messages.modifications == self._refreshed_modifications:
+            for message in messages:
+                if message.is_refresh_needed(self._strict):
+                    message.refresh(self._strict)
+
+                self._add_message(message)
+
+            self._messages += messages
+            self._refreshed_modifications = self._messages.modifications
+        else:
+            self._messages += messages
+            self.refresh()
+
+    def memory_report(self):
+        """Returns a dictionary of the approximate number of bytes used by
+        the database, by category, and their sum as ``'total'``:
+
+        - ``'index'``: The messages list and the lookup tables.
+
+        - ``'messages'``: Messages, and their comments, senders and
+          other containers.
+
+        - ``'signals'``: Signals, and their receivers, comments and
+          high precision values.
+
+        - ``'choices'``: Signal choices. Identical choices are shared
+          and counted once.
+
+        - ``'codecs'``: Codecs, signal trees, decoders, encoders and
+          decode caches created on first use or by
+          :meth:`.precompile()`.
+
+        - ``'dbc'``: DBC specific attributes and definitions.
+
+        - ``'strings'``: All names, units, comments and other
+          strings. Names and units are interned, and shared strings
+          are counted once.
+
+        - ``'other'``: Nodes, buses and everything else.
+
+        >>> db.memory_report()
+        {'index': 1664, 'messages': 7016, 'signals': 11152, ...}
+
+        """
+
+        return memory_report(self)
 
     def __repr__(self):
         lines = []
@@ -0,0 +1,94 @@
+# A bounded cache of decoded messages.
+
+from collections import OrderedDict
+
+
+class DecodeCache(object):
+    """A cache of decoded messages keyed by raw data and decode options,
+    holding at most `size` entries. The least recently used entry is
+    discarded when the cache is full. The default size of one only
+    remembers the last decoded message, which is enough for periodic
+    messages that rarely change.
+
+    Use :meth:`Message.enable_decode_cache()<cantools.database.can.Message.enable_decode_cache()>`
+    to enable the cache of a message.
+
+    """
+
+    def __init__(self, size=1):
+        if size < 1:
+            raise ValueError(
+                'Expected decode cache size at least 1, but got {}.'.format(
+                    size))
+
+        self._size = size
+        self._entries = OrderedDict()
+        self._hits = 0
+        self._misses = 0
+
+    @property
+    def size(self):
+        """The maximum number of cached messages.
+
+        """
+
+        return self._size
+
+    @property
+    def hits(self):
+        """The number of decoded messages found in the cache.
+
+        """
+
+        return self._hits
+
+    @property
+    def misses(self):
+        """The number of decoded messages not found in the cache.
+
+        """
+
+        return self._misses
+
+    def get(self, key):
+        """Returns the decoded message of given key, or ``None`` if not in
+        the cache.
+
+        """
+
+        try:
+            value = self._entries[key]
+        except KeyError:
+            self._misses += 1
+
+            return None
+
+        if self._size > 1:
+            self._entries.move_to_end(key)
+
+        self._hits += 1
+
+        return value
+
+    def put(self, key, value):
+        self._entries[key] = value
+
+        if len(self._entries) > self._size:
+            self._entries.popitem(last=False)
+
+    def clear(self):
+        """Remove all cached messages and reset the hit and miss counters.
+
+        """
+
+        self._entries.clear()
+        self._hits = 0
+        self._misses = 0
+
+    def __len__(self):
+        return len(self._entries)
+
+    def __repr__(self):
+        return 'decode_cache(size={}, hits={}, misses={})'.format(self._size,
+                                                                 self._hits,
+                                                                 self._misses)
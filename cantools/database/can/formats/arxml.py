@@ -10,6 +10,7 @@ from ..signal import Signal, NamedSignalValue
 from ..signal import Decimal as SignalDecimal
 from ..message import Message
 from ..internal_database import InternalDatabase
+from .utils import ALL_MESSAGES
 
 
 LOGGER = logging.getLogger(__name__)
@@ -26,9 +27,10 @@ def parse_int_string(in_string):
     return int(in_string, 0) # autodetect the base
 
 class SystemLoader(object):
-    def __init__(self, root, strict):
+    def __init__(self, root, strict, message_filter=ALL_MESSAGES):
         self._root = root
         self._strict = strict
+        self._message_filter = message_filter
 
         m = re.match('^\\{(.*)\\}AUTOSAR$', self._root.tag)
 
@@ -67,7 +69,9 @@ class SystemLoader(object):
         if self.autosar_version_major != 4 and self.autosar_version_major != 3:
             raise ValueError('This class only supports AUTOSAR versions 3 and 4')
 
-        self._arxml_reference_cache = {}
+        # Absolute ARXML path to package element index, created on
+        # first use.
+        self._arxml_reference_index = None
 
     def autosar_version_newer(self, major, minor=None, patch=None):
         """Returns true iff the AUTOSAR version specified in the ARXML it at
@@ -149,11 +153,24 @@ class SystemLoader(object):
     def _load_package_contents(self, package_elem, messages):
         # This code extracts the information about CAN clusters of an
         # individual AR package. TODO: deal with the individual buses
+        can_clusters = self._get_arxml_children(package_elem,
+                                                [
+                                                    'ELEMENTS',
+                                                    '*&CAN-CLUSTER'
+                                                ])
+
+        # the short names of the CAN clusters are matched against the
+        # bus names of the message filter
+        can_clusters = [
+            can_cluster
+            for can_cluster in can_clusters
+            if self._message_filter.matches_bus(
+                    self._load_can_cluster_name(can_cluster))
+        ]
+
         if self.autosar_version_newer(4):
             frame_triggerings_spec = \
                 [
-                    'ELEMENTS',
-                    '*&CAN-CLUSTER',
                     'CAN-CLUSTER-VARIANTS',
                     '*&CAN-CLUSTER-CONDITIONAL',
                     'PHYSICAL-CHANNELS',
@@ -164,8 +181,6 @@ class SystemLoader(object):
         else: # AUTOSAR 3
             frame_triggerings_spec = \
                 [
-                    'ELEMENTS',
-                    '*&CAN-CLUSTER',
                     'PHYSICAL-CHANNELS',
                     '*&PHYSICAL-CHANNEL',
 
@@ -178,13 +193,25 @@ class SystemLoader(object):
                 ]
 
         can_frame_triggerings = \
-            self._get_arxml_children(package_elem, frame_triggerings_spec)
+            self._get_arxml_children(can_clusters, frame_triggerings_spec)
 
         for can_frame_triggering in can_frame_triggerings:
-            messages.append(self._load_message(can_frame_triggering))
+            message = self._load_message(can_frame_triggering)
+
+            if message is not None:
+                messages.append(message)
+
+    def _load_can_cluster_name(self, can_cluster):
+        short_name = self._get_unique_arxml_child(can_cluster, 'SHORT-NAME')
+
+        if short_name is None:
+            return None
+
+        return short_name.text
 
     def _load_message(self, can_frame_triggering):
-        """Load given message and return a message object.
+        """Load given message and return a message object, or ``None`` if
+        it does not match the message filter.
 
         """
 
@@ -199,6 +226,10 @@ class SystemLoader(object):
         frame_id = self._load_message_frame_id(can_frame_triggering)
         length = self._load_message_length(can_frame)
         is_extended_frame = self._load_message_is_extended_frame(can_frame_triggering)
+
+        if not self._message_filter.matches_frame_id(frame_id):
+            return None
+
         comments = self._load_comments(can_frame)
 
         # ToDo: senders
@@ -257,6 +288,9 @@ class SystemLoader(object):
                 if signal is not None:
                     signals.append(signal)
 
+        if not self._message_filter.matches_nodes(senders, signals):
+            return None
+
         return Message(frame_id=frame_id,
                        is_extended_frame=is_extended_frame,
                        name=name,
@@ -749,14 +783,22 @@ class SystemLoader(object):
         exists, a ValueError exception is raised.
         """
 
-        is_absolute_path = arxml_path.startswith('/')
+        if arxml_path.startswith('/'):
+            # absolute paths are globally unique and thus can be
+            # looked up in the index
+            if self._arxml_reference_index is None:
+                self._arxml_reference_index = \
+                    self._create_arxml_reference_index()
 
-        if is_absolute_path and arxml_path in self._arxml_reference_cache:
-            # absolute paths are globally unique and thus can be cached
-            return self._arxml_reference_cache[arxml_path]
+            result = self._arxml_reference_index.get(arxml_path)
+
+            if result is not None:
+                if result.tag != f'{{{self.xml_namespace}}}{child_tag_name}':
+                    result = None
+
+            return result
 
         # TODO (?): for relative paths, we need to find the corresponding package tag for each base element!
-        base_elem = self._root if is_absolute_path else base_elem
         if not base_elem:
             raise ValueError(
                 'Tried to dereference a relative ARXML path without '
@@ -794,12 +836,55 @@ class SystemLoader(object):
                 'ELEMENTS',
                 "{}/[ns:SHORT-NAME='{}']".format(child_tag_name, short_names[-1]) ]
 
-        result = base_elem.find(make_xpath(location), self._xml_namespaces)
+        return base_elem.find(make_xpath(location), self._xml_namespaces)
 
-        if is_absolute_path:
-            self._arxml_reference_cache[arxml_path] = result
+    def _create_arxml_reference_index(self):
+        """Returns a dictionary of the absolute ARXML paths of all
+        elements of all packages, and the elements themselves. Created
+        in a single pass over the package structure, so that
+        following a reference does not need to search the tree.
 
-        return result
+        """
+
+        index = {}
+
+        # in AUTOSAR3, the top level packages are located beneath the
+        # TOP-LEVEL-PACKAGES tag, and sub-packages use
+        # SUB-PACKAGES. AUTOSAR 4 always uses AR-PACKAGES.
+        if self.autosar_version_newer(4):
+            top_level_packages_tag = 'AR-PACKAGES'
+            sub_packages_tag = 'AR-PACKAGES'
+        else:
+            top_level_packages_tag = 'TOP-LEVEL-PACKAGES'
+            sub_packages_tag = 'SUB-PACKAGES'
+
+        ns = f'{{{self.xml_namespace}}}'
+
+        def handle_package_list(path, package_list):
+            for package in package_list:
+                if package.tag != ns + 'AR-PACKAGE':
+                    continue
+
+                package_path = path + '/' + _get_short_name(package, ns)
+
+                for child in package:
+                    if child.tag == ns + 'ELEMENTS':
+                        for element in child:
+                            element_path = \
+                                package_path + '/' + _get_short_name(element,
+                                                                     ns)
+
+                            # the first element of any path is used,
+                            # just as when searching the tree
+                            index.setdefault(element_path, element)
+                    elif child.tag == ns + sub_packages_tag:
+                        handle_package_list(package_path, child)
+
+        for package_list in self._root:
+            if package_list.tag == ns + top_level_packages_tag:
+                handle_package_list('', package_list)
+
+        return index
 
     def _follow_arxml3_const_reference(self, base_elem, arxml_const_path, child_tag_name):
         """This method is does the same as _follow_arxml_ref() but for constant specifications.
@@ -987,6 +1072,14 @@ class SystemLoader(object):
                                                 '&BASE-TYPE'
                                             ])
 
+def _get_short_name(elem, ns):
+    for child in elem:
+        if child.tag == ns + 'SHORT-NAME':
+            return child.text
+
+    return ''
+
+
 # The ARXML XML namespace for the EcuExtractLoader
 NAMESPACE = 'http://autosar.org/schema/r4.0'
 NAMESPACES = {'ns': NAMESPACE}
@@ -1023,9 +1116,15 @@ REFERENCE_VALUES_XPATH = make_xpath([
 
 class EcuExtractLoader(object):
 
-    def __init__(self, root, strict):
+    def __init__(self, root, strict, message_filter=ALL_MESSAGES):
         self.root = root
         self.strict = strict
+        self.message_filter = message_filter
+
+        # Per package Com signal and CanIf PDU indexes, created on
+        # first use.
+        self._values = {}
+        self._can_if_rx_tx_pdu_cfgs = {}
 
     def load(self):
         buses = []
@@ -1067,6 +1166,10 @@ class EcuExtractLoader(object):
                                 version)
 
     def load_message(self, com_i_pdu):
+        # ECU extract messages have no bus.
+        if not self.message_filter.matches_bus(None):
+            return None
+
         # Default values.
         interval = None
         senders = []
@@ -1116,6 +1219,9 @@ class EcuExtractLoader(object):
 
             return None
 
+        if not self.message_filter.matches_frame_id(frame_id):
+            return None
+
         # ToDo: interval, senders, comments
 
         # Find all signals in this message.
@@ -1136,6 +1242,9 @@ class EcuExtractLoader(object):
             if signal is not None:
                 signals.append(signal)
 
+        if not self.message_filter.matches_nodes(senders, signals):
+            return None
+
         return Message(frame_id=frame_id,
                        is_extended_frame=is_extended_frame,
                        name=name,
@@ -1267,24 +1376,68 @@ class EcuExtractLoader(object):
                               NAMESPACES)
 
     def find_value(self, xpath):
-        return self.root.find(make_xpath([
-            "AR-PACKAGES",
-            "AR-PACKAGE/[ns:SHORT-NAME='{}']".format(xpath.split('/')[1]),
-            "ELEMENTS",
-            "ECUC-MODULE-CONFIGURATION-VALUES/[ns:SHORT-NAME='Com']",
-            "CONTAINERS",
-            "ECUC-CONTAINER-VALUE/[ns:SHORT-NAME='ComConfig']",
-            "SUB-CONTAINERS",
-            "ECUC-CONTAINER-VALUE/[ns:SHORT-NAME='{}']".format(xpath.split('/')[-1])
-        ]),
-                              NAMESPACES)
+        package = xpath.split('/')[1]
+
+        try:
+            values = self._values[package]
+        except KeyError:
+            values = self.create_values_index(package)
+            self._values[package] = values
+
+        return values.get(xpath.split('/')[-1])
+
+    def create_values_index(self, package):
+        """Returns a dictionary of short names and ECUC container values
+        of the Com configuration in given package.
+
+        """
+
+        values = {}
+        ecuc_container_values = self.root.iterfind(
+            make_xpath([
+                "AR-PACKAGES",
+                "AR-PACKAGE/[ns:SHORT-NAME='{}']".format(package),
+                "ELEMENTS",
+                "ECUC-MODULE-CONFIGURATION-VALUES/[ns:SHORT-NAME='Com']",
+                "CONTAINERS",
+                "ECUC-CONTAINER-VALUE/[ns:SHORT-NAME='ComConfig']",
+                "SUB-CONTAINERS",
+                "ECUC-CONTAINER-VALUE"
+            ]),
+            NAMESPACES)
+
+        for ecuc_container_value in ecuc_container_values:
+            short_name = ecuc_container_value.find(SHORT_NAME_XPATH,
+                                                   NAMESPACES)
+
+            if short_name is not None:
+                values.setdefault(short_name.text, ecuc_container_value)
+
+        return values
 
     def find_can_if_rx_tx_pdu_cfg(self, com_pdu_id_ref):
+        package = com_pdu_id_ref.split('/')[1]
+
+        try:
+            can_if_rx_tx_pdu_cfgs = self._can_if_rx_tx_pdu_cfgs[package]
+        except KeyError:
+            can_if_rx_tx_pdu_cfgs = self.create_can_if_rx_tx_pdu_cfgs_index(
+                package)
+            self._can_if_rx_tx_pdu_cfgs[package] = can_if_rx_tx_pdu_cfgs
+
+        return can_if_rx_tx_pdu_cfgs.get(com_pdu_id_ref)
+
+    def create_can_if_rx_tx_pdu_cfgs_index(self, package):
+        """Returns a dictionary of referenced Com PDUs and CanIf Rx and Tx
+        PDU configurations in given package.
+
+        """
+
+        can_if_rx_tx_pdu_cfgs = {}
         messages = self.root.iterfind(
             make_xpath([
                 "AR-PACKAGES",
-                "AR-PACKAGE/[ns:SHORT-NAME='{}']".format(
-                    com_pdu_id_ref.split('/')[1]),
+                "AR-PACKAGE/[ns:SHORT-NAME='{}']".format(package),
                 "ELEMENTS",
                 "ECUC-MODULE-CONFIGURATION-VALUES/[ns:SHORT-NAME='CanIf']",
                 'CONTAINERS',
@@ -1307,8 +1460,9 @@ class EcuExtractLoader(object):
 
             for reference, value in self.iter_reference_values(message):
                 if reference == expected_reference:
-                    if value == com_pdu_id_ref:
-                        return message
+                    can_if_rx_tx_pdu_cfgs.setdefault(value, message)
+
+        return can_if_rx_tx_pdu_cfgs
 
     def iter_parameter_values(self, param_conf_container):
         parameters = param_conf_container.find(PARAMETER_VALUES_XPATH,
@@ -1348,13 +1502,106 @@ def is_ecu_extract(root):
     return ecuc_value_collection is not None
 
 
-def load_string(string, strict=True):
-    """Parse given ARXML format string.
+# Tags of the package elements needed to load a database, in
+# addition to all PDUs. Other package elements are dropped by
+# load(). AUTOSAR 3 data types are referenced by system signals.
+PACKAGE_ELEMENT_TAGS = set([
+    'CAN-CLUSTER',
+    'CAN-FRAME',
+    'FRAME',
+    'I-SIGNAL',
+    'I-SIGNAL-GROUP',
+    'SYSTEM-SIGNAL',
+    'SYSTEM-SIGNAL-GROUP',
+    'COMPU-METHOD',
+    'UNIT',
+    'SW-BASE-TYPE',
+    'CONSTANT-SPECIFICATION',
+    'INTEGER-TYPE',
+    'REAL-TYPE',
+    'BOOLEAN-TYPE',
+    'OPAQUE-TYPE',
+    'CHAR-TYPE',
+    'STRING-TYPE',
+    'ARRAY-TYPE',
+    'RECORD-TYPE',
+    'ECUC-VALUE-COLLECTION',
+    'ECUC-MODULE-CONFIGURATION-VALUES'
+])
+
+
+def _is_needed_package_element(tag):
+    tag = tag.rpartition('}')[2]
+
+    return tag in PACKAGE_ELEMENT_TAGS or tag.endswith('-PDU')
+
+
+def _parse_needed(fp):
+    """Incrementally parse given ARXML file-like object and return the
+    root element. Package elements not needed to load a database,
+    for example software components and ECU instances, are removed
+    as soon as they are parsed, so that memory usage depends on the
+    CAN contents rather than the file size.
+
+    """
+
+    parents = []
+    root = None
+
+    for event, elem in ElementTree.iterparse(fp, events=('start', 'end')):
+        if event == 'start':
+            parents.append(elem)
+
+            continue
+
+        parents.pop()
+
+        if len(parents) >= 2:
+            parent = parents[-1]
+
+            if (parent.tag.endswith('}ELEMENTS')
+                and parents[-2].tag.endswith('}AR-PACKAGE')
+                and not _is_needed_package_element(elem.tag)):
+                # The element is the last child of its parent.
+                del parent[-1]
+
+        root = elem
+
+    return root
+
+
+def check_message_filter(message_filter):
+    """Raise a ValueError if given message filter cannot be applied to
+    ARXML files. Message senders and signal receivers are not loaded,
+    so messages cannot be filtered by node. Bus names are the short
+    names of the CAN clusters.
+
+    """
+
+    if message_filter.nodes is not None:
+        raise ValueError('ARXML files cannot be filtered by node.')
+
+
+def load(fp, strict=True, message_filter=ALL_MESSAGES):
+    """Parse given ARXML file-like object incrementally, without keeping
+    package elements not needed to load the database in memory. Only
+    messages matching given message filter are loaded.
 
     """
 
-    root = ElementTree.fromstring(string)
+    return _load_root(_parse_needed(fp), strict, message_filter)
+
+
+def load_string(string, strict=True, message_filter=ALL_MESSAGES):
+    """Parse given ARXML format string. Only messages matching given
+    message filter are loaded.
+
+    """
+
+    return _load_root(ElementTree.fromstring(string), strict, message_filter)
+
 
+def _load_root(root, strict, message_filter):
     m = re.match("{(.*)}AUTOSAR", root.tag)
     if not m:
         raise ValueError(f"No XML namespace specified or illegal root tag name '{root.tag}'")
@@ -1377,6 +1624,6 @@ def load_string(string, strict=True):
                     ROOT_TAG,
                     root.tag))
 
-        return EcuExtractLoader(root, strict).load()
+        return EcuExtractLoader(root, strict, message_filter).load()
     else:
-        return SystemLoader(root, strict).load()
+        return SystemLoader(root, strict, message_filter).load()
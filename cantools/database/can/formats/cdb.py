@@ -0,0 +1,741 @@
+# Load and dump a CAN database in CDB format, a compact binary format
+# loaded much faster than the text formats.
+#
+# All values of the database are stored in a single pool of
+# constants, each stored once. Scalars are stored in flat tables per
+# type, and tuples as item indexes into the pool. A tuple only refers
+# to constants before it, so the whole pool is created in one pass
+# when loaded. Messages, signals and all other objects are tuples of
+# their attributes in a fixed order.
+
+import struct
+import sys
+import zlib
+from array import array
+from collections import OrderedDict as odict
+from decimal import Decimal
+from itertools import accumulate
+
+from ..attribute import Attribute
+from ..attribute_definition import AttributeDefinition
+from ..bus import Bus
+from ..environment_variable import EnvironmentVariable
+from ..internal_database import InternalDatabase
+from ..message import Message
+from ..node import Node
+from ..signal import Decimal as SignalDecimal
+from ..signal import NamedSignalValue
+from ..signal import Signal
+from ..signal_group import SignalGroup
+from ...errors import Error
+from ...errors import ParseError
+from .dbc import DbcSpecifics
+from .utils import ALL_MESSAGES
+
+
+MAGIC = b'\x89CDB\r\n\x1a\n'
+
+# Increment when the format is changed in an incompatible way.
+VERSION = 2
+
+# Magic, version and CRC-32 of the data after the header.
+HEADER = struct.Struct('<8sII')
+
+# Number of strings, decimals and large integers, the size of their
+# UTF-8 encoded text, and number of integers, floats and tuples.
+COUNTS = struct.Struct('<IIIIIII')
+
+# The constants always first in the pool.
+NONE = 0
+FALSE = 1
+TRUE = 2
+
+
+def _check_array_itemsizes():
+    for typecode, itemsize in [('I', 4), ('q', 8), ('d', 8)]:
+        if array(typecode).itemsize != itemsize:
+            raise Error(
+                "The CDB format requires array type '{}' to be {} bytes.".format(
+                    typecode,
+                    itemsize))
+
+
+def _to_bytes(values):
+    if sys.byteorder == 'big':
+        values = array(values.typecode, values)
+        values.byteswap()
+
+    return values.tobytes()
+
+
+def _from_bytes(typecode, data, offset, count):
+    values = array(typecode)
+    end = offset + count * values.itemsize
+
+    if end > len(data):
+        raise ParseError('CDB data is truncated.')
+
+    values.frombytes(data[offset:end])
+
+    if sys.byteorder == 'big':
+        values.byteswap()
+
+    return values, end
+
+
+class _Writer(object):
+    """Adds values to the pool of constants and returns their references.
+
+    """
+
+    # Kinds of constants, in pool order.
+    STRING = 0
+    DECIMAL = 1
+    LARGE_INTEGER = 2
+    INTEGER = 3
+    FLOAT = 4
+    TUPLE = 5
+    FIXED = 6
+
+    def __init__(self):
+        self._constants = [{}, {}, {}, {}, {}, {}]
+
+    def add(self, value):
+        if value is None:
+            return (self.FIXED, NONE)
+        elif value is False:
+            return (self.FIXED, FALSE)
+        elif value is True:
+            return (self.FIXED, TRUE)
+        elif isinstance(value, str):
+            kind = self.STRING
+            key = value
+        elif isinstance(value, Decimal):
+            kind = self.DECIMAL
+            key = str(value)
+        elif isinstance(value, int):
+            if -2 ** 63 <= value < 2 ** 63:
+                kind = self.INTEGER
+            else:
+                kind = self.LARGE_INTEGER
+
+            key = int(value)
+        elif isinstance(value, float):
+            kind = self.FLOAT
+            key = struct.pack('<d', value)
+        elif isinstance(value, tuple):
+            kind = self.TUPLE
+            key = tuple([self.add(item) for item in value])
+        else:
+            raise Error(
+                "Unsupported value {!r} of type '{}' in CDB format.".format(
+                    value,
+                    type(value).__name__))
+
+        constants = self._constants[kind]
+
+        try:
+            index = constants[key]
+        except KeyError:
+            index = len(constants)
+            constants[key] = index
+
+        return (kind, index)
+
+    def dump(self, root):
+        root = self.add(root)
+        (strings,
+         decimals,
+         large_integers,
+         integers,
+         floats,
+         tuples) = self._constants
+        bases = [3]
+
+        for constants in self._constants:
+            bases.append(bases[-1] + len(constants))
+
+        bases[self.FIXED] = 0
+        lengths = array('I')
+        texts = []
+
+        for text in list(strings) + list(decimals) + list(large_integers):
+            text = str(text)
+            lengths.append(len(text))
+            texts.append(text)
+
+        text = ''.join(texts).encode('utf-8')
+        integers = array('q', integers)
+        floats = array('d', [struct.unpack('<d', key)[0] for key in floats])
+        sizes = array('I')
+        items = array('I')
+
+        for key in tuples:
+            sizes.append(len(key))
+            items.extend([bases[kind] + index for kind, index in key])
+
+        data = b''.join([
+            COUNTS.pack(len(strings),
+                        len(decimals),
+                        len(large_integers),
+                        len(text),
+                        len(integers),
+                        len(floats),
+                        len(sizes)),
+            struct.pack('<II', len(items), bases[root[0]] + root[1]),
+            _to_bytes(lengths),
+            text,
+            _to_bytes(integers),
+            _to_bytes(floats),
+            _to_bytes(sizes),
+            _to_bytes(items)
+        ])
+
+        return HEADER.pack(MAGIC, VERSION, zlib.crc32(data)) + data
+
+
+def _load_constants(data):
+    """Returns the root tuple in given data, with all references to other
+    constants replaced by their values.
+
+    """
+
+    _check_array_itemsizes()
+
+    if data[:len(MAGIC)] != MAGIC:
+        raise ParseError('Invalid CDB magic.')
+
+    try:
+        version, = struct.unpack_from('<I', data, len(MAGIC))
+    except struct.error:
+        raise ParseError('CDB data is truncated.')
+
+    if version != VERSION:
+        raise ParseError(
+            'Unsupported CDB format version {}, only version {} is '
+            'supported.'.format(version, VERSION))
+
+    if len(data) < HEADER.size:
+        raise ParseError('CDB data is truncated.')
+
+    _, _, checksum = HEADER.unpack_from(data)
+
+    # Corrupt data is detected here instead of creating invalid
+    # objects below.
+    if zlib.crc32(memoryview(data)[HEADER.size:]) != checksum:
+        raise ParseError('Invalid CDB checksum.')
+
+    try:
+        (number_of_strings,
+         number_of_decimals,
+         number_of_large_integers,
+         text_size,
+         number_of_integers,
+         number_of_floats,
+         number_of_tuples) = COUNTS.unpack_from(data, HEADER.size)
+        offset = HEADER.size + COUNTS.size
+        number_of_items, root = struct.unpack_from('<II', data, offset)
+    except struct.error:
+        raise ParseError('CDB data is truncated.')
+
+    offset += 8
+    number_of_texts = (number_of_strings
+                       + number_of_decimals
+                       + number_of_large_integers)
+    lengths, offset = _from_bytes('I', data, offset, number_of_texts)
+
+    if offset + text_size > len(data):
+        raise ParseError('CDB data is truncated.')
+
+    try:
+        text = bytes(data[offset:offset + text_size]).decode('utf-8')
+    except UnicodeDecodeError:
+        raise ParseError('Invalid CDB text.')
+
+    offset += text_size
+    integers, offset = _from_bytes('q', data, offset, number_of_integers)
+    floats, offset = _from_bytes('d', data, offset, number_of_floats)
+    sizes, offset = _from_bytes('I', data, offset, number_of_tuples)
+    items, offset = _from_bytes('I', data, offset, number_of_items)
+    ends = list(accumulate(lengths))
+    texts = list(map(text.__getitem__, map(slice, [0] + ends, ends)))
+
+    constants = [None, False, True]
+    constants += texts[:number_of_strings]
+
+    try:
+        constants += map(Decimal,
+                         texts[number_of_strings:
+                               number_of_strings + number_of_decimals])
+        constants += map(int, texts[number_of_strings + number_of_decimals:])
+    except (ArithmeticError, ValueError):
+        raise ParseError('Invalid CDB number.')
+
+    constants += integers
+    constants += floats
+    items = items.tolist()
+    getitem = constants.__getitem__
+    append = constants.append
+    begin = 0
+
+    try:
+        # Tuples only refers to constants before them, so a reference
+        # to a later tuple raises IndexError.
+        for size in sizes:
+            end = begin + size
+            append(tuple(map(getitem, items[begin:end])))
+            begin = end
+
+        return constants[root]
+    except IndexError:
+        raise ParseError('Invalid CDB constant reference.')
+
+
+def _dump_dict(dictionary):
+    if dictionary is None:
+        return None
+
+    items = []
+
+    for key, value in dictionary.items():
+        items.append(key)
+        items.append(value)
+
+    return tuple(items)
+
+
+def _load_dict(items):
+    if items is None:
+        return None
+
+    return dict(zip(items[0::2], items[1::2]))
+
+
+def _dump_choices(choices):
+    if choices is None:
+        return None
+
+    items = []
+
+    for key, value in choices.items():
+        if isinstance(value, NamedSignalValue):
+            items.append((key,
+                          value.name,
+                          value.value,
+                          _dump_dict(value.comments)))
+        else:
+            items.append((key, value))
+
+    return tuple(items)
+
+
+def _load_choices(items):
+    if items is None:
+        return None
+
+    choices = {}
+
+    for item in items:
+        if len(item) == 2:
+            choices[item[0]] = item[1]
+        else:
+            key, name, value, comments = item
+            choices[key] = NamedSignalValue(value, name, _load_dict(comments))
+
+    return choices
+
+
+class _DbcDumper(object):
+
+    def __init__(self):
+        self._definitions = {}
+
+    def dump_definition(self, definition):
+        choices = definition.choices
+
+        if choices is not None:
+            choices = tuple(choices)
+
+        return (definition.name,
+                definition.default_value,
+                definition.kind,
+                definition.type_name,
+                definition.minimum,
+                definition.maximum,
+                choices)
+
+    def dump_definitions(self, definitions):
+        # The same definitions are referred to by the database, node,
+        # message and signal DBC specifics. Dumped once.
+        key = id(definitions)
+
+        if key not in self._definitions:
+            self._definitions[key] = (
+                definitions,
+                tuple([(name, self.dump_definition(definition))
+                       for name, definition in definitions.items()]))
+
+        return self._definitions[key][1]
+
+    def dump(self, dbc):
+        # SYM databases have an empty list instead of DBC specifics.
+        if not isinstance(dbc, DbcSpecifics):
+            return None
+
+        attributes = tuple([
+            (name, attribute.value, self.dump_definition(attribute.definition))
+            for name, attribute in dbc.attributes.items()
+        ])
+        environment_variables = tuple([
+            (name,
+             variable.name,
+             variable.env_type,
+             variable.minimum,
+             variable.maximum,
+             variable.unit,
+             variable.initial_value,
+             variable.env_id,
+             variable.access_type,
+             variable.access_node,
+             variable.comment)
+            for name, variable in dbc.environment_variables.items()
+        ])
+        value_tables = tuple([
+            (name, _dump_choices(choices))
+            for name, choices in dbc.value_tables.items()
+        ])
+
+        return (attributes,
+                self.dump_definitions(dbc.attribute_definitions),
+                environment_variables,
+                value_tables)
+
+
+class _LazyDbcSpecifics(DbcSpecifics):
+    """Node, message or signal DBC specifics with attributes created on
+    first access.
+
+    """
+
+    def __init__(self, loader, items, definitions):
+        # The base class constructor is not called as it creates all
+        # dictionaries.
+        self._loader = loader
+        self._items = items
+        self._attributes = None
+        self._attribute_definitions = definitions
+        self._environment_variables = None
+        self._value_tables = None
+
+    @property
+    def attributes(self):
+        if self._attributes is None:
+            self._attributes = self._loader.load_attributes(self._items)
+            self._loader = None
+            self._items = None
+
+        return self._attributes
+
+    @attributes.setter
+    def attributes(self, value):
+        self._attributes = value
+        self._loader = None
+        self._items = None
+
+    @property
+    def environment_variables(self):
+        if self._environment_variables is None:
+            self._environment_variables = odict()
+
+        return self._environment_variables
+
+    @property
+    def value_tables(self):
+        if self._value_tables is None:
+            self._value_tables = odict()
+
+        return self._value_tables
+
+
+class _DbcLoader(object):
+
+    def __init__(self):
+        self._definitions = {}
+        self._definitions_dicts = {}
+
+    def load_definition(self, items):
+        # Attributes share their definitions.
+        key = id(items)
+
+        try:
+            return self._definitions[key][1]
+        except KeyError:
+            pass
+
+        name, default_value, kind, type_name, minimum, maximum, choices = items
+
+        if choices is not None:
+            choices = list(choices)
+
+        definition = AttributeDefinition(name,
+                                         default_value,
+                                         kind,
+                                         type_name,
+                                         minimum,
+                                         maximum,
+                                         choices)
+        self._definitions[key] = (items, definition)
+
+        return definition
+
+    def load_definitions(self, items):
+        key = id(items)
+
+        try:
+            return self._definitions_dicts[key][1]
+        except KeyError:
+            pass
+
+        definitions = odict([(name, self.load_definition(definition))
+                             for name, definition in items])
+        self._definitions_dicts[key] = (items, definitions)
+
+        return definitions
+
+    def load_attributes(self, items):
+        return odict([
+            (name, Attribute(value, self.load_definition(definition)))
+            for name, value, definition in items
+        ])
+
+    def load(self, items):
+        if items is None:
+            return None
+
+        attributes, definitions, environment_variables, value_tables = items
+        definitions = self.load_definitions(definitions)
+
+        if environment_variables or value_tables:
+            return DbcSpecifics(
+                self.load_attributes(attributes),
+                definitions,
+                odict([(name, EnvironmentVariable(*variable))
+                       for name, *variable in environment_variables]),
+                odict([(name, _load_choices(choices))
+                       for name, choices in value_tables]))
+        else:
+            return _LazyDbcSpecifics(self, attributes, definitions)
+
+
+def _dump_decimal(decimal):
+    if decimal is None:
+        return None
+
+    return (decimal.scale, decimal.offset, decimal.minimum, decimal.maximum)
+
+
+def _dump_signal(signal, dbc_dumper):
+    multiplexer_ids = signal.multiplexer_ids
+
+    if multiplexer_ids is not None:
+        multiplexer_ids = tuple(multiplexer_ids)
+
+    return (signal.name,
+            signal.start,
+            signal.length,
+            signal.byte_order,
+            signal.is_signed,
+            signal.initial,
+            signal.scale,
+            signal.offset,
+            signal.minimum,
+            signal.maximum,
+            signal.unit,
+            _dump_choices(signal.choices),
+            dbc_dumper.dump(signal.dbc),
+            _dump_dict(signal.comments),
+            tuple(signal.receivers),
+            signal.is_multiplexer,
+            multiplexer_ids,
+            signal.multiplexer_signal,
+            signal.is_float,
+            _dump_decimal(signal.decimal),
+            signal.spn)
+
+
+def _load_signal(items, dbc_loader):
+    (name,
+     start,
+     length,
+     byte_order,
+     is_signed,
+     initial,
+     scale,
+     offset,
+     minimum,
+     maximum,
+     unit,
+     choices,
+     dbc,
+     comments,
+     receivers,
+     is_multiplexer,
+     multiplexer_ids,
+     multiplexer_signal,
+     is_float,
+     decimal,
+     spn) = items
+
+    if multiplexer_ids is not None:
+        multiplexer_ids = list(multiplexer_ids)
+
+    if decimal is not None:
+        decimal = SignalDecimal(*decimal)
+
+    return Signal(name,
+                  start,
+                  length,
+                  byte_order,
+                  is_signed,
+                  initial,
+                  scale,
+                  offset,
+                  minimum,
+                  maximum,
+                  unit,
+                  _load_choices(choices),
+                  dbc_loader.load(dbc),
+                  _load_dict(comments),
+                  list(receivers),
+                  is_multiplexer,
+                  multiplexer_ids,
+                  multiplexer_signal,
+                  is_float,
+                  decimal,
+                  spn)
+
+
+def _dump_message(message, dbc_dumper):
+    signal_groups = message.signal_groups
+
+    if signal_groups is not None:
+        signal_groups = tuple([(signal_group.name,
+                                signal_group.repetitions,
+                                tuple(signal_group.signal_names))
+                               for signal_group in signal_groups])
+
+    return (message.frame_id,
+            message.is_extended_frame,
+            message.name,
+            message.length,
+            tuple([_dump_signal(signal, dbc_dumper)
+                   for signal in message.signals]),
+            _dump_dict(message.comments),
+            tuple(message.senders),
+            message.send_type,
+            message.cycle_time,
+            dbc_dumper.dump(message.dbc),
+            message.bus_name,
+            signal_groups,
+            message.protocol)
+
+
+def _load_message(items, dbc_loader, strict, message_filter):
+    (frame_id,
+     is_extended_frame,
+     name,
+     length,
+     signals,
+     comments,
+     senders,
+     send_type,
+     cycle_time,
+     dbc,
+     bus_name,
+     signal_groups,
+     protocol) = items
+
+    if not message_filter.matches_frame_id(frame_id):
+        return None
+
+    if not message_filter.matches_bus(bus_name):
+        return None
+
+    signals = [_load_signal(signal, dbc_loader) for signal in signals]
+    senders = list(senders)
+
+    if not message_filter.matches_nodes(senders, signals):
+        return None
+
+    if signal_groups is not None:
+        signal_groups = [SignalGroup(name, repetitions, list(signal_names))
+                         for name, repetitions, signal_names in signal_groups]
+
+    return Message(frame_id,
+                   name,
+                   length,
+                   signals,
+                   _load_dict(comments),
+                   senders,
+                   send_type,
+                   cycle_time,
+                   dbc_loader.load(dbc),
+                   is_extended_frame,
+                   bus_name,
+                   signal_groups,
+                   strict,
+                   protocol)
+
+
+def dump_string(database):
+    """Format given database in CDB format. Returns bytes.
+
+    """
+
+    dbc_dumper = _DbcDumper()
+    nodes = tuple([(node.name, node.comment, dbc_dumper.dump(node.dbc))
+                   for node in database.nodes])
+    buses = tuple([(bus.name, bus.comment, bus.baudrate)
+                   for bus in database.buses])
+    messages = tuple([_dump_message(message, dbc_dumper)
+                      for message in database.messages])
+
+    return _Writer().dump((database.version,
+                           nodes,
+                           buses,
+                           messages,
+                           dbc_dumper.dump(database.dbc)))
+
+
+def load_string(data, strict=True, message_filter=ALL_MESSAGES):
+    """Parse given CDB bytes. Only messages matching given message
+    filter are loaded.
+
+    """
+
+    root = _load_constants(data)
+
+    try:
+        version, nodes, buses, messages, dbc = root
+    except (TypeError, ValueError):
+        raise ParseError('Invalid CDB root.')
+
+    dbc_loader = _DbcLoader()
+
+    # Objects of unexpected types or sizes in the constants pool.
+    try:
+        messages = [
+            _load_message(message, dbc_loader, strict, message_filter)
+            for message in messages
+        ]
+
+        return InternalDatabase(
+            [message for message in messages if message is not None],
+            [Node(name, comment, dbc_loader.load(dbc))
+             for name, comment, dbc in nodes],
+            [Bus(name, comment, baudrate)
+             for name, comment, baudrate in buses],
+            version,
+            dbc_loader.load(dbc))
+    except (TypeError, ValueError, AttributeError, LookupError) as e:
+        raise ParseError('Invalid CDB object: {}'.format(e))
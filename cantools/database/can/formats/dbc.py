@@ -33,6 +33,7 @@ from ..internal_database import InternalDatabase
 from ..environment_variable import EnvironmentVariable
 
 from .utils import num
+from .utils import ALL_MESSAGES
 
 
 DBC_FMT = (
@@ -345,25 +346,580 @@ class Parser(textparser.Parser):
                 version))
 
 
+# Regular expressions of the fast parser, matching the same tokens as
+# the textparser based parser above. Each token may be preceded by
+# whitespace and comments.
+_SKIP = r'(?:[ \r\n\t]+|//[^\n]*\n)*'
+_KEYWORD = r'(?:{})(?![A-Za-z0-9_])'.format('|'.join([
+    'BA_DEF_DEF_REL_', 'BA_DEF_DEF_', 'BA_DEF_REL_', 'BA_DEF_SGTYPE_',
+    'BA_DEF_', 'BA_REL_', 'BA_SGTYPE_', 'BA_', 'BO_TX_BU_', 'BO_', 'BS_',
+    'BU_BO_REL_', 'BU_EV_REL_', 'BU_SG_REL_', 'BU_', 'CAT_DEF_', 'CAT_',
+    'CM_', 'ENVVAR_DATA_', 'EV_DATA_', 'EV_', 'FILTER', 'NS_DESC_', 'NS_',
+    'SG_MUL_VAL_', 'SGTYPE_VAL_', 'SGTYPE_', 'SG_', 'SIG_GROUP_',
+    'SIG_TYPE_REF_', 'SIG_VALTYPE_', 'SIGTYPE_VALTYPE_', 'VAL_TABLE_',
+    'VAL_', 'VERSION'
+]))
+_NUMBER = r'([-+]?\d+\.?\d*(?:[eE][+-]?\d+)?)(?![\d.])'
+_WORD = r'(?!{})([A-Za-z_][A-Za-z0-9_]*)(?![A-Za-z0-9_])'.format(_KEYWORD)
+_STRING = r'"((?:\\"|[^"])*?)"'
+_VALUE = r'(?:{}|{})'.format(_NUMBER, _STRING)
+
+
+def _fast_re(*items):
+    """Returns a compiled regular expression of given tokens, each
+    preceded by whitespace and comments. Keywords and punctuation are
+    given as is, and other tokens as the regular expressions above.
+
+    """
+
+    pattern = []
+
+    for item in items:
+        if re.fullmatch(r'[A-Z_]+', item):
+            item = item + r'(?![A-Za-z0-9_])'
+        elif len(item) == 1:
+            item = re.escape(item)
+
+        pattern.append(_SKIP + item)
+
+    return re.compile(''.join(pattern))
+
+
+_FAST_STATEMENT_KEYWORD = re.compile(_SKIP + r'([A-Za-z0-9_]+)')
+_FAST_END = re.compile(_SKIP + r'\Z')
+_FAST_COLON = _fast_re(':')
+_FAST_COMMA = _fast_re(',')
+_FAST_SCOLON = _fast_re(';')
+_FAST_NUMBER = _fast_re(_NUMBER)
+_FAST_WORD = _fast_re(_WORD)
+_FAST_STRING = _fast_re(_STRING)
+_FAST_NUMBER_STRING = _fast_re(_NUMBER, _STRING)
+_FAST_NUMBER_NUMBER = _fast_re(_NUMBER, _NUMBER)
+_FAST_ANY = _fast_re(r'(?:{}|([A-Za-z0-9_]+)|{}|([()\[\],|@+\-;:]))'.format(
+    _NUMBER,
+    _STRING))
+_FAST_VERSION = _fast_re('VERSION', _STRING)
+_FAST_NS = _fast_re('NS_', ':')
+_FAST_BS = _fast_re('BS_', ':')
+_FAST_BU = _fast_re('BU_', ':')
+_FAST_BO = _fast_re('BO_', _NUMBER, _WORD, ':', _NUMBER, _WORD)
+_FAST_SG = _fast_re('SG_',
+                    _WORD,
+                    r'(?:{})?'.format(_WORD),
+                    ':',
+                    _NUMBER,
+                    '|',
+                    _NUMBER,
+                    '@',
+                    _NUMBER,
+                    r'([+-])(?!\d)',
+                    '(',
+                    _NUMBER,
+                    ',',
+                    _NUMBER,
+                    ')',
+                    '[',
+                    _NUMBER,
+                    '|',
+                    _NUMBER,
+                    ']',
+                    _STRING,
+                    _WORD)
+_FAST_EV = _fast_re('EV_', _WORD, ':', _NUMBER, '[', _NUMBER, '|', _NUMBER, ']',
+                    _STRING, _NUMBER, _NUMBER, _WORD, _WORD, ';')
+_FAST_CM = _fast_re('CM_')
+_FAST_CM_SG = _fast_re('SG_', _NUMBER, _WORD, _STRING, ';')
+_FAST_CM_BO = _fast_re('BO_', _NUMBER, _STRING, ';')
+_FAST_CM_EV = _fast_re('EV_', _WORD, _STRING, ';')
+_FAST_CM_BU = _fast_re('BU_', _WORD, _STRING, ';')
+_FAST_CM_STRING = _fast_re(_STRING, ';')
+_FAST_BA_DEF = _fast_re('BA_DEF_',
+                        r'(?:(SG_|BO_|EV_|BU_)(?![A-Za-z0-9_]))?',
+                        _STRING,
+                        _WORD)
+_FAST_BA_DEF_DEF = _fast_re('BA_DEF_DEF_', _STRING, _VALUE, ';')
+_FAST_BA = _fast_re('BA_', _STRING)
+_FAST_BA_OBJECT = _fast_re(
+    r'(?:(BO_)(?![A-Za-z0-9_]){}{}'
+    r'|(SG_)(?![A-Za-z0-9_]){}{}{}{}'
+    r'|(BU_|EV_)(?![A-Za-z0-9_]){}{})'.format(_SKIP, _NUMBER,
+                                              _SKIP, _NUMBER, _SKIP, _WORD,
+                                              _SKIP, _WORD))
+_FAST_VALUE_SCOLON = _fast_re(_VALUE, ';')
+_FAST_BA_DEF_REL = _fast_re('BA_DEF_REL_',
+                            r'(?:(BU_SG_REL_)(?![A-Za-z0-9_]))?',
+                            _STRING,
+                            _WORD)
+_FAST_BA_DEF_DEF_REL = _fast_re('BA_DEF_DEF_REL_', _STRING, _VALUE, ';')
+_FAST_BA_REL = _fast_re('BA_REL_', _STRING, 'BU_SG_REL_', _WORD, 'SG_', _NUMBER,
+                        _WORD, _VALUE, ';')
+_FAST_VAL = _fast_re('VAL_', r'(?:{})?'.format(_NUMBER), _WORD)
+_FAST_VAL_TABLE = _fast_re('VAL_TABLE_', _WORD)
+_FAST_SIG_VALTYPE = _fast_re('SIG_VALTYPE_', _NUMBER, _WORD, ':', _NUMBER, ';')
+_FAST_SG_MUL_VAL = _fast_re('SG_MUL_VAL_', _NUMBER, _WORD, _WORD)
+_FAST_BO_TX_BU = _fast_re('BO_TX_BU_', _NUMBER, ':')
+_FAST_SIG_GROUP = _fast_re('SIG_GROUP_', _NUMBER, _WORD, _NUMBER, ':')
+
+
+class _FastParseError(Exception):
+    pass
+
+
+class FastParser(object):
+    """A DBC parser creating the same parse tree as :class:`Parser`, but
+    much faster. Each statement is parsed by regular expressions
+    selected by its leading keyword. Raises ``ValueError`` if given
+    string could not be parsed, in which case :class:`Parser` should
+    be used to get a detailed error.
+
+    """
+
+    def __init__(self):
+        self._statements = {
+            'VERSION': self._parse_version,
+            'NS_': self._parse_ns,
+            'BS_': self._parse_bs,
+            'BU_': self._parse_bu,
+            'BO_': self._parse_bo,
+            'EV_': self._parse_ev,
+            'CM_': self._parse_cm,
+            'BA_DEF_': self._parse_ba_def,
+            'BA_DEF_DEF_': self._parse_ba_def_def,
+            'BA_': self._parse_ba,
+            'BA_DEF_REL_': self._parse_ba_def_rel,
+            'BA_DEF_DEF_REL_': self._parse_ba_def_def_rel,
+            'BA_REL_': self._parse_ba_rel,
+            'VAL_': self._parse_val,
+            'VAL_TABLE_': self._parse_val_table,
+            'SIG_VALTYPE_': self._parse_sig_valtype,
+            'SG_MUL_VAL_': self._parse_sg_mul_val,
+            'BO_TX_BU_': self._parse_bo_tx_bu,
+            'SIG_GROUP_': self._parse_sig_group
+        }
+        self._string = None
+
+    def parse(self, string):
+        self._string = string
+        tokens = {}
+        pos = 0
+
+        try:
+            while True:
+                mo = _FAST_END.match(string, pos)
+
+                if mo is not None and tokens:
+                    break
+
+                mo = _FAST_STATEMENT_KEYWORD.match(string, pos)
+
+                if mo is None:
+                    raise _FastParseError()
+
+                keyword = mo.group(1)
+
+                try:
+                    parse_statement = self._statements[keyword]
+                except KeyError:
+                    raise _FastParseError()
+
+                statement, pos = parse_statement(pos)
+                tokens.setdefault(keyword, []).append(statement)
+        except _FastParseError:
+            raise ValueError('Invalid DBC at offset {}.'.format(pos))
+        finally:
+            self._string = None
+
+        return tokens
+
+    def _match(self, regex, pos):
+        mo = regex.match(self._string, pos)
+
+        if mo is None:
+            raise _FastParseError()
+
+        return mo
+
+    def _values(self, regex, pos):
+        """Returns all values matched by given regular expression from
+        given position, and the position after them.
+
+        """
+
+        values = []
+
+        while True:
+            mo = regex.match(self._string, pos)
+
+            if mo is None:
+                return values, pos
+
+            values.append(mo.group(1))
+            pos = mo.end()
+
+    def _delimited_values(self, regex, pos):
+        mo = self._match(regex, pos)
+        values = [mo.group(1)]
+        pos = mo.end()
+
+        while True:
+            mo = _FAST_COMMA.match(self._string, pos)
+
+            if mo is None:
+                return values, pos
+
+            mo = self._match(regex, mo.end())
+            values.append(mo.group(1))
+            pos = mo.end()
+
+    def _pairs(self, regex, pos):
+        pairs = []
+
+        while True:
+            mo = regex.match(self._string, pos)
+
+            if mo is None:
+                return pairs, pos
+
+            pairs.append(list(mo.groups()))
+            pos = mo.end()
+
+    def _scolon(self, pos):
+        return self._match(_FAST_SCOLON, pos).end()
+
+    def _parse_version(self, pos):
+        mo = self._match(_FAST_VERSION, pos)
+
+        return ['VERSION', _unescape(mo.group(1))], mo.end()
+
+    def _parse_ns(self, pos):
+        pos = self._match(_FAST_NS, pos).end()
+        values = []
+
+        # Until any token followed by a colon.
+        while True:
+            mo = self._match(_FAST_ANY, pos)
+
+            if _FAST_COLON.match(self._string, mo.end()):
+                return ['NS_', ':', values], pos
+
+            values.append(_any_value(mo))
+            pos = mo.end()
+
+    def _parse_bs(self, pos):
+        return ['BS_', ':'], self._match(_FAST_BS, pos).end()
+
+    def _parse_bu(self, pos):
+        pos = self._match(_FAST_BU, pos).end()
+        nodes, pos = self._values(_FAST_WORD, pos)
+
+        return ['BU_', ':', nodes], pos
+
+    def _parse_bo(self, pos):
+        mo = self._match(_FAST_BO, pos)
+        frame_id, name, length, sender = mo.groups()
+        pos = mo.end()
+        signals = []
+
+        while True:
+            mo = _FAST_SG.match(self._string, pos)
+
+            if mo is None:
+                break
+
+            (signal_name,
+             multiplexer,
+             start,
+             signal_length,
+             byte_order,
+             sign,
+             scale,
+             offset,
+             minimum,
+             maximum,
+             unit,
+             receiver) = mo.groups()
+            receivers = [receiver]
+            pos = mo.end()
+
+            while True:
+                mo = _FAST_COMMA.match(self._string, pos)
+
+                if mo is None:
+                    break
+
+                mo = _FAST_WORD.match(self._string, mo.end())
+
+                if mo is None:
+                    # The comma is not part of the signal.
+                    break
+
+                receivers.append(mo.group(1))
+                pos = mo.end()
+
+            if multiplexer is None:
+                names = [signal_name]
+            else:
+                names = [signal_name, multiplexer]
+
+            signals.append([
+                'SG_', names, ':', start, '|', signal_length, '@', byte_order,
+                sign, '(', scale, ',', offset, ')', '[', minimum, '|', maximum,
+                ']', _unescape(unit), receivers
+            ])
+
+        return ['BO_', frame_id, name, ':', length, sender, signals], pos
+
+    def _parse_ev(self, pos):
+        mo = self._match(_FAST_EV, pos)
+        (name,
+         env_type,
+         minimum,
+         maximum,
+         unit,
+         initial_value,
+         env_id,
+         access_type,
+         access_node) = mo.groups()
+
+        return [
+            'EV_', name, ':', env_type, '[', minimum, '|', maximum, ']',
+            _unescape(unit), initial_value, env_id, access_type, access_node,
+            ';'
+        ], mo.end()
+
+    def _parse_cm(self, pos):
+        pos = self._match(_FAST_CM, pos).end()
+        mo = _FAST_CM_SG.match(self._string, pos)
+
+        if mo is not None:
+            frame_id, name, comment = mo.groups()
+            item = ['SG_', frame_id, name, _unescape(comment)]
+        else:
+            for kind, regex in [('BO_', _FAST_CM_BO),
+                                ('EV_', _FAST_CM_EV),
+                                ('BU_', _FAST_CM_BU)]:
+                mo = regex.match(self._string, pos)
+
+                if mo is not None:
+                    name, comment = mo.groups()
+                    item = [kind, name, _unescape(comment)]
+                    break
+            else:
+                mo = self._match(_FAST_CM_STRING, pos)
+                item = _unescape(mo.group(1))
+
+        return ['CM_', item, ';'], mo.end()
+
+    def _parse_definition_values(self, pos, require_values):
+        mo = _FAST_STRING.match(self._string, pos)
+
+        if mo is not None:
+            values, pos = self._delimited_values(_FAST_STRING, pos)
+            values = [_unescape(value) for value in values]
+        else:
+            values, pos = self._values(_FAST_NUMBER, pos)
+
+            if require_values and not values:
+                raise _FastParseError()
+
+        return values, pos
+
+    def _parse_ba_def(self, pos):
+        mo = self._match(_FAST_BA_DEF, pos)
+        kind, name, type_name = mo.groups()
+        values, pos = self._parse_definition_values(mo.end(), False)
+
+        return [
+            'BA_DEF_', [] if kind is None else [kind], _unescape(name),
+            type_name, [values], ';'
+        ], self._scolon(pos)
+
+    def _parse_ba_def_def(self, pos):
+        mo = self._match(_FAST_BA_DEF_DEF, pos)
+        name, number, string = mo.groups()
+
+        return ['BA_DEF_DEF_',
+                _unescape(name),
+                _value(number, string),
+                ';'], mo.end()
+
+    def _parse_ba(self, pos):
+        mo = self._match(_FAST_BA, pos)
+        name = _unescape(mo.group(1))
+        pos = mo.end()
+        objects = []
+
+        while True:
+            mo = _FAST_BA_OBJECT.match(self._string, pos)
+
+            if mo is None:
+                break
+
+            (bo, bo_frame_id,
+             sg, sg_frame_id, sg_name,
+             kind, kind_name) = mo.groups()
+
+            if bo is not None:
+                objects.append([bo, bo_frame_id])
+            elif sg is not None:
+                objects.append([sg, sg_frame_id, sg_name])
+            else:
+                objects.append([kind, kind_name])
+
+            pos = mo.end()
+
+        mo = self._match(_FAST_VALUE_SCOLON, pos)
+
+        return ['BA_', name, objects, _value(*mo.groups()), ';'], mo.end()
+
+    def _parse_ba_def_rel(self, pos):
+        mo = self._match(_FAST_BA_DEF_REL, pos)
+        kind, name, type_name = mo.groups()
+        values, pos = self._parse_definition_values(mo.end(), True)
+
+        return [
+            'BA_DEF_REL_', [] if kind is None else [kind], _unescape(name),
+            type_name, values, ';'
+        ], self._scolon(pos)
+
+    def _parse_ba_def_def_rel(self, pos):
+        mo = self._match(_FAST_BA_DEF_DEF_REL, pos)
+        name, number, string = mo.groups()
+
+        return ['BA_DEF_DEF_REL_',
+                _unescape(name),
+                _value(number, string),
+                ';'], mo.end()
+
+    def _parse_ba_rel(self, pos):
+        mo = self._match(_FAST_BA_REL, pos)
+        name, node, frame_id, signal, number, string = mo.groups()
+
+        return [
+            'BA_REL_', _unescape(name), 'BU_SG_REL_', node, 'SG_', frame_id,
+            signal, _value(number, string), ';'
+        ], mo.end()
+
+    def _parse_choices(self, pos):
+        pairs, pos = self._pairs(_FAST_NUMBER_STRING, pos)
+
+        for pair in pairs:
+            pair[1] = _unescape(pair[1])
+
+        return pairs, self._scolon(pos)
+
+    def _parse_val(self, pos):
+        mo = self._match(_FAST_VAL, pos)
+        frame_id, name = mo.groups()
+        choices, pos = self._parse_choices(mo.end())
+
+        return [
+            'VAL_', [] if frame_id is None else [frame_id], name, choices, ';'
+        ], pos
+
+    def _parse_val_table(self, pos):
+        mo = self._match(_FAST_VAL_TABLE, pos)
+        choices, pos = self._parse_choices(mo.end())
+
+        return ['VAL_TABLE_', mo.group(1), choices, ';'], pos
+
+    def _parse_sig_valtype(self, pos):
+        mo = self._match(_FAST_SIG_VALTYPE, pos)
+        frame_id, name, signal_type = mo.groups()
+
+        return ['SIG_VALTYPE_', frame_id, name, ':', signal_type, ';'], mo.end()
+
+    def _parse_sg_mul_val(self, pos):
+        mo = self._match(_FAST_SG_MUL_VAL, pos)
+        frame_id, name, multiplexer = mo.groups()
+        pos = mo.end()
+        mo = self._match(_FAST_NUMBER_NUMBER, pos)
+        ranges = [list(mo.groups())]
+        pos = mo.end()
+
+        while True:
+            mo = _FAST_COMMA.match(self._string, pos)
+
+            if mo is None:
+                break
+
+            mo = self._match(_FAST_NUMBER_NUMBER, mo.end())
+            ranges.append(list(mo.groups()))
+            pos = mo.end()
+
+        return [
+            'SG_MUL_VAL_', frame_id, name, multiplexer, ranges, ';'
+        ], self._scolon(pos)
+
+    def _parse_bo_tx_bu(self, pos):
+        mo = self._match(_FAST_BO_TX_BU, pos)
+        senders, pos = self._delimited_values(_FAST_WORD, mo.end())
+
+        return ['BO_TX_BU_', mo.group(1), ':', senders, ';'], self._scolon(pos)
+
+    def _parse_sig_group(self, pos):
+        mo = self._match(_FAST_SIG_GROUP, pos)
+        frame_id, name, repetitions = mo.groups()
+        signals, pos = self._values(_FAST_WORD, mo.end())
+
+        return [
+            'SIG_GROUP_', frame_id, name, repetitions, ':', signals, ';'
+        ], self._scolon(pos)
+
+
+def _unescape(string):
+    return string.replace('\\"', '"')
+
+
+def _value(number, string):
+    if number is not None:
+        return number
+    else:
+        return _unescape(string)
+
+
+def _any_value(mo):
+    number, word, string, punctuation = mo.groups()
+
+    if string is not None:
+        return _unescape(string)
+
+    for value in [number, word, punctuation]:
+        if value is not None:
+            return value
+
+
+def _parse(string):
+    """Returns the parse tree of given DBC string, created by the fast
+    parser, or by the textparser based parser to get a detailed error
+    if the fast parser fails.
+
+    """
+
+    try:
+        return FastParser().parse(string)
+    except ValueError:
+        return Parser().parse(string)
+
+
 class DbcSpecifics(object):
 
+    __slots__ = (
+        '_attributes',
+        '_attribute_definitions',
+        '_environment_variables',
+        '_value_tables'
+    )
+
     def __init__(self,
                  attributes=None,
                  attribute_definitions=None,
                  environment_variables=None,
                  value_tables=None):
-        if attributes is None:
-            attributes = odict()
-
-        if attribute_definitions is None:
-            attribute_definitions = odict()
-
-        if environment_variables is None:
-            environment_variables = odict()
-
-        if value_tables is None:
-            value_tables = odict()
-
+        # Missing dictionaries are created on first access, as most
+        # nodes, messages and signals have no attributes, and only the
+        # database has definitions, environment variables and value
+        # tables.
         self._attributes = attributes
         self._attribute_definitions = attribute_definitions
         self._environment_variables = environment_variables
@@ -376,6 +932,9 @@ class DbcSpecifics(object):
 
         """
 
+        if self._attributes is None:
+            self._attributes = odict()
+
         return self._attributes
 
     @attributes.setter
@@ -388,6 +947,9 @@ class DbcSpecifics(object):
 
         """
 
+        if self._attribute_definitions is None:
+            self._attribute_definitions = odict()
+
         return self._attribute_definitions
 
     @property
@@ -397,6 +959,9 @@ class DbcSpecifics(object):
 
         """
 
+        if self._value_tables is None:
+            self._value_tables = odict()
+
         return self._value_tables
 
     @property
@@ -406,6 +971,9 @@ class DbcSpecifics(object):
 
         """
 
+        if self._environment_variables is None:
+            self._environment_variables = odict()
+
         return self._environment_variables
 
 
@@ -1304,8 +1872,9 @@ def _load_messages(tokens,
                    signal_multiplexer_values,
                    strict,
                    bus_name,
-                   signal_groups):
-    """Load messages.
+                   signal_groups,
+                   message_filter):
+    """Load messages matching given filter.
 
     """
 
@@ -1401,6 +1970,9 @@ def _load_messages(tokens,
 
     messages = []
 
+    if not message_filter.matches_bus(bus_name):
+        return messages
+
     for message in tokens.get('BO_', []):
         # Any message named VECTOR__INDEPENDENT_SIG_MSG contains
         # signals not assigned to any message. Cantools does not yet
@@ -1413,6 +1985,9 @@ def _load_messages(tokens,
         frame_id = frame_id_dbc & 0x7fffffff
         is_extended_frame = bool(frame_id_dbc & 0x80000000)
 
+        if not message_filter.matches_frame_id(frame_id):
+            continue
+
         # Senders.
         senders = [_get_node_name(attributes, message[5])]
 
@@ -1445,6 +2020,9 @@ def _load_messages(tokens,
                                 frame_id_dbc,
                                 multiplexer_signal)
 
+        if not message_filter.matches_nodes(senders, signals):
+            continue
+
         messages.append(
             Message(frame_id=frame_id,
                     is_extended_frame=is_extended_frame,
@@ -1695,12 +2273,13 @@ def get_definitions_dict(definitions, defaults):
     return result
 
 
-def load_string(string, strict=True):
-    """Parse given string.
+def load_string(string, strict=True, message_filter=ALL_MESSAGES):
+    """Parse given string. Only messages matching given message filter
+    are loaded.
 
     """
 
-    tokens = Parser().parse(string)
+    tokens = _parse(string)
 
     comments = _load_comments(tokens)
     definitions = _load_attribute_definitions(tokens)
@@ -1724,7 +2303,8 @@ def load_string(string, strict=True):
                               signal_multiplexer_values,
                               strict,
                               bus.name if bus else None,
-                              signal_groups)
+                              signal_groups,
+                              message_filter)
     nodes = _load_nodes(tokens, comments, attributes, attribute_definitions)
     version = _load_version(tokens)
     environment_variables = _load_environment_variables(tokens, comments, attributes)
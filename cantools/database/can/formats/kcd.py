@@ -18,6 +18,7 @@ from ..bus import Bus
 from ..internal_database import InternalDatabase
 from ...utils import start_bit
 from .utils import num
+from .utils import ALL_MESSAGES
 
 
 LOGGER = logging.getLogger(__name__)
@@ -168,8 +169,9 @@ def _load_multiplex_element(mux, nodes):
     return signals
 
 
-def _load_message_element(message, bus_name, nodes, strict):
-    """Load given message element and return a message object.
+def _load_message_element(message, bus_name, nodes, strict, message_filter):
+    """Load given message element and return a message object, or
+    ``None`` if the message does not match given filter.
 
     """
 
@@ -198,6 +200,9 @@ def _load_message_element(message, bus_name, nodes, strict):
             LOGGER.debug("Ignoring unsupported message attribute '%s'.", key)
             # TODO: triggered, count, remote
 
+    if not message_filter.matches_frame_id(frame_id):
+        return None
+
     # Comment.
     try:
         notes = message.find('ns:Notes', NAMESPACES).text
@@ -230,6 +235,9 @@ def _load_message_element(message, bus_name, nodes, strict):
     else:
         length = int(length)
 
+    if not message_filter.matches_nodes(senders, signals):
+        return None
+
     return Message(frame_id=frame_id,
                    is_extended_frame=is_extended_frame,
                    name=name,
@@ -454,8 +462,9 @@ def dump_string(database):
         return ElementTree.tostring(network_definition)
 
 
-def load_string(string, strict=True):
-    """Parse given KCD format string.
+def load_string(string, strict=True, message_filter=ALL_MESSAGES):
+    """Parse given KCD format string. Only messages matching given
+    message filter are loaded.
 
     """
 
@@ -482,11 +491,18 @@ def load_string(string, strict=True):
         bus_baudrate = int(bus.get('baudrate', 500000))
         buses.append(Bus(bus_name, baudrate=bus_baudrate))
 
+        if not message_filter.matches_bus(bus_name):
+            continue
+
         for message in bus.iterfind('ns:Message', NAMESPACES):
-            messages.append(_load_message_element(message,
-                                                  bus_name,
-                                                  nodes,
-                                                  strict))
+            message = _load_message_element(message,
+                                            bus_name,
+                                            nodes,
+                                            strict,
+                                            message_filter)
+
+            if message is not None:
+                messages.append(message)
 
     return InternalDatabase(messages,
                             [
@@ -24,6 +24,7 @@ from ..message import Message
 from ..internal_database import InternalDatabase
 
 from .utils import num
+from .utils import ALL_MESSAGES
 from ...errors import ParseError
 
 
@@ -589,7 +590,8 @@ def _load_message(frame_id,
                   message_section_tokens,
                   signals,
                   enums,
-                  strict):
+                  strict,
+                  message_filter):
     #print(message_tokens)
     # Default values.
     name = message_tokens[1]
@@ -610,6 +612,14 @@ def _load_message(frame_id,
     if message_tokens[3]['ID'][0][-1]:
         comment = _load_comment(message_tokens[3]['ID'][0][-1][0])
 
+    message_signals = _load_message_signals(message_tokens,
+                                            message_section_tokens,
+                                            signals,
+                                            enums)
+
+    if not message_filter.matches_nodes([], message_signals):
+        return None
+
     return Message(frame_id=frame_id,
                    is_extended_frame=is_extended_frame,
                    name=name,
@@ -617,10 +627,7 @@ def _load_message(frame_id,
                    senders=[],
                    send_type=None,
                    cycle_time=cycle_time,
-                   signals=_load_message_signals(message_tokens,
-                                                 message_section_tokens,
-                                                 signals,
-                                                 enums),
+                   signals=message_signals,
                    comment=comment,
                    bus_name=None,
                    strict=strict)
@@ -646,7 +653,12 @@ def _parse_message_frame_ids(message):
     return frame_ids, is_extended_frame(message[2])
 
 
-def _load_message_section(section_name, tokens, signals, enums, strict):
+def _load_message_section(section_name,
+                          tokens,
+                          signals,
+                          enums,
+                          strict,
+                          message_filter):
     def has_frame_id(message):
         return 'ID' in message[3]
 
@@ -660,22 +672,38 @@ def _load_message_section(section_name, tokens, signals, enums, strict):
         frame_ids, is_extended_frame = _parse_message_frame_ids(message_tokens)
 
         for frame_id in frame_ids:
+            if not message_filter.matches_frame_id(frame_id):
+                continue
+
             message = _load_message(frame_id,
                                     is_extended_frame,
                                     message_tokens,
                                     message_section_tokens,
                                     signals,
                                     enums,
-                                    strict)
-            messages.append(message)
+                                    strict,
+                                    message_filter)
+
+            if message is not None:
+                messages.append(message)
 
     return messages
 
 
-def _load_messages(tokens, signals, enums, strict):
-    messages = _load_message_section('{SEND}', tokens, signals, enums, strict)
-    messages += _load_message_section('{RECEIVE}', tokens, signals, enums, strict)
-    messages += _load_message_section('{SENDRECEIVE}', tokens, signals, enums, strict)
+def _load_messages(tokens, signals, enums, strict, message_filter):
+    # SYM messages have no bus.
+    if not message_filter.matches_bus(None):
+        return []
+
+    messages = []
+
+    for section_name in ['{SEND}', '{RECEIVE}', '{SENDRECEIVE}']:
+        messages += _load_message_section(section_name,
+                                          tokens,
+                                          signals,
+                                          enums,
+                                          strict,
+                                          message_filter)
 
     return messages
 
@@ -684,8 +712,9 @@ def _load_version(tokens):
     return tokens[1][2]
 
 
-def load_string(string, strict=True):
-    """Parse given string.
+def load_string(string, strict=True, message_filter=ALL_MESSAGES):
+    """Parse given string. Only messages matching given message filter
+    are loaded.
 
     """
 
@@ -697,7 +726,7 @@ def load_string(string, strict=True):
     version = _load_version(tokens)
     enums = _load_enums(tokens)
     signals = _load_signals(tokens, enums)
-    messages = _load_messages(tokens, signals, enums, strict)
+    messages = _load_messages(tokens, signals, enums, strict, message_filter)
 
     return InternalDatabase(messages,
                             [],
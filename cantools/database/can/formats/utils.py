@@ -9,3 +9,46 @@ def num(number_as_string):
         return float(number_as_string)
     else:
         raise ValueError('Expected integer or floating point number.')
+
+
+class MessageFilter(object):
+    """Selects the messages to load by bus name, node name and frame
+    id. A criterion given as ``None`` matches all messages. A message
+    matches given nodes if any of them sends the message or receives
+    any of its signals.
+
+    """
+
+    def __init__(self, buses=None, nodes=None, frame_ids=None):
+        self.buses = None if buses is None else set(buses)
+        self.nodes = None if nodes is None else set(nodes)
+        self.frame_ids = None if frame_ids is None else set(frame_ids)
+
+    def matches_bus(self, bus_name):
+        return self.buses is None or bus_name in self.buses
+
+    def matches_frame_id(self, frame_id):
+        return self.frame_ids is None or frame_id in self.frame_ids
+
+    def matches_nodes(self, senders, signals):
+        if self.nodes is None:
+            return True
+
+        if not self.nodes.isdisjoint(senders):
+            return True
+
+        return any(not self.nodes.isdisjoint(signal.receivers)
+                   for signal in signals)
+
+    def as_key(self):
+        """Returns a hashable representation of the criteria, for example
+        to be used in cache keys.
+
+        """
+
+        return tuple(None if criterion is None else tuple(sorted(criterion))
+                     for criterion in [self.buses, self.nodes, self.frame_ids])
+
+
+# Matches all messages.
+ALL_MESSAGES = MessageFilter()
@@ -0,0 +1,85 @@
+# A read-only mapping of signals decoded on first access.
+
+from collections.abc import Mapping
+
+
+class LazyDecodedMessage(Mapping):
+    """A read-only mapping of signal name-value entries of a message,
+    decoded from the raw data on first access and then cached.
+
+    Iterating over, or getting the length of, a multiplexed message
+    decodes all signals, as the signals in it depend on the
+    multiplexers.
+
+    Returned by :meth:`Message.decode()<cantools.database.can.Message.decode()>`
+    if `lazy` is ``True``.
+
+    """
+
+    __slots__ = (
+        '_message',
+        '_data',
+        '_decode_choices',
+        '_scaling',
+        '_values',
+        '_is_complete'
+    )
+
+    def __init__(self, message, data, decode_choices, scaling, values=None):
+        self._message = message
+        self._data = data
+        self._decode_choices = decode_choices
+        self._scaling = scaling
+
+        if values is None:
+            self._values = {}
+            self._is_complete = False
+        else:
+            self._values = values
+            self._is_complete = True
+
+    @property
+    def data(self):
+        """The raw data.
+
+        """
+
+        return self._data
+
+    def _decode_all(self):
+        if not self._is_complete:
+            self._values = self._message.decode(self._data,
+                                                self._decode_choices,
+                                                self._scaling)
+            self._is_complete = True
+
+        return self._values
+
+    def __getitem__(self, name):
+        try:
+            return self._values[name]
+        except KeyError:
+            if self._is_complete:
+                raise
+
+        decoder = self._message._get_selected_decoder(frozenset([name]))
+        value = decoder(self._data, self._decode_choices, self._scaling)[name]
+        self._values[name] = value
+
+        return value
+
+    def __iter__(self):
+        if self._message.is_multiplexed():
+            return iter(self._decode_all())
+
+        # Same order as Message.decode().
+        return iter(signal.name for signal in self._message._codecs['signals'])
+
+    def __len__(self):
+        if self._message.is_multiplexed():
+            return len(self._decode_all())
+
+        return len(self._message._codecs['signals'])
+
+    def __repr__(self):
+        return repr(dict(self))
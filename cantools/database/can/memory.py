@@ -0,0 +1,179 @@
+# Approximate memory usage of a database.
+
+import sys
+
+from .message import Message
+from .message import _Codec
+from .signal import Signal
+from .signal import Decimal
+from .signal import NamedSignalValue
+from .signal import FrozenChoices
+from .attribute import Attribute
+from .attribute_definition import AttributeDefinition
+from .formats.dbc import DbcSpecifics
+
+
+CATEGORIES = (
+    'index',
+    'messages',
+    'signals',
+    'choices',
+    'codecs',
+    'dbc',
+    'strings',
+    'other'
+)
+
+# Objects of these types, or of subclasses of them, and everything
+# only reachable from them, are counted in given category.
+TYPE_CATEGORIES = {
+    Message: 'messages',
+    Signal: 'signals',
+    Decimal: 'signals',
+    FrozenChoices: 'choices',
+    NamedSignalValue: 'choices',
+    _Codec: 'codecs',
+    Attribute: 'dbc',
+    AttributeDefinition: 'dbc',
+    DbcSpecifics: 'dbc'
+}
+
+# Message attributes only used to encode and decode.
+CODEC_ATTRIBUTES = frozenset([
+    '_codec_tree',
+    '_decoder',
+    '_encoder',
+    '_tuple_decoder',
+    '_record_decoder',
+    '_tuple_type',
+    '_record_type',
+    '_selected_decoders',
+    '_values_encoders',
+    '_decode_cache',
+    '_signal_tree',
+    '_codec_module_choices'
+])
+
+# Back references to objects counted elsewhere.
+SKIPPED_ATTRIBUTES = frozenset(['_messages', '_signal'])
+
+CONTAINER_TYPES = (dict, list, tuple, set, frozenset)
+
+
+def _slot_names(obj):
+    for cls in type(obj).__mro__:
+        slots = cls.__dict__.get('__slots__', ())
+
+        if isinstance(slots, str):
+            slots = (slots, )
+
+        for name in slots:
+            if name != '__weakref__':
+                yield name
+
+
+def _object_attributes(obj):
+    """Yields the attribute name and value pairs of given object.
+
+    """
+
+    for name in _slot_names(obj):
+        try:
+            yield name, getattr(obj, name)
+        except AttributeError:
+            pass
+
+    if hasattr(obj, '__dict__'):
+        yield from vars(obj).items()
+
+
+def _type_category(obj, category):
+    for cls in type(obj).__mro__:
+        if cls in TYPE_CATEGORIES:
+            return TYPE_CATEGORIES[cls]
+
+    return category
+
+
+def _is_counted_object(obj):
+    return type(obj).__module__.startswith('cantools.')
+
+
+class _Counter(object):
+
+    def __init__(self):
+        self.report = dict.fromkeys(CATEGORIES, 0)
+        self._seen = set()
+
+    def add(self, obj, category):
+        """Add the size of given object, and of all objects only
+        reachable from it, to the report. Each object is only counted
+        once, in the category it is found in first.
+
+        """
+
+        stack = [(obj, category)]
+
+        while stack:
+            obj, category = stack.pop()
+
+            if obj is None or id(obj) in self._seen:
+                continue
+
+            self._seen.add(id(obj))
+            category = _type_category(obj, category)
+
+            if isinstance(obj, (str, bytes)):
+                self.report['strings'] += sys.getsizeof(obj)
+                continue
+
+            self.report[category] += sys.getsizeof(obj)
+
+            if isinstance(obj, dict):
+                for key, value in obj.items():
+                    stack.append((key, category))
+                    stack.append((value, category))
+            elif isinstance(obj, CONTAINER_TYPES):
+                for item in obj:
+                    stack.append((item, category))
+            elif _is_counted_object(obj):
+                if hasattr(obj, '__dict__'):
+                    self.report[category] += sys.getsizeof(vars(obj))
+
+                for name, value in _object_attributes(obj):
+                    if name in SKIPPED_ATTRIBUTES:
+                        continue
+
+                    if isinstance(obj, Message) and name in CODEC_ATTRIBUTES:
+                        stack.append((value, 'codecs'))
+                    else:
+                        stack.append((value, category))
+
+
+def memory_report(database):
+    """Returns a dictionary of the approximate number of bytes used by
+    given database, by category. See :meth:`Database.memory_report()
+    <cantools.database.can.Database.memory_report()>`.
+
+    """
+
+    counter = _Counter()
+
+    # Messages first, so that their contents are not counted as
+    # part of the lookup tables.
+    for message in database.messages:
+        counter.add(message, 'messages')
+
+    for name, value in _object_attributes(database):
+        if name in ['_messages',
+                    '_name_to_message',
+                    '_frame_id_to_message']:
+            counter.add(value, 'index')
+        else:
+            counter.add(value, 'other')
+
+    counter.add(database, 'index')
+    report = counter.report
+    report['total'] = sum(report.values())
+
+    return report
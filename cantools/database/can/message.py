@@ -1,12 +1,31 @@
 # A CAN message.
 
 import binascii
+from collections.abc import Mapping
 from copy import deepcopy
+from types import MappingProxyType
 
 from .signal import NamedSignalValue
+from .python_source import generate_decoder
+from .python_source import generate_encoder
+from .python_source import generate_record_decoder
+from .python_source import generate_tuple_decoder
+from .python_source import generate_values_encoder
+from .python_source import _signal_mask
+from .batch import RowError
+from .batch import count_rows
+from .batch import decode_batch
+from .batch import encode_batch
+from .batch import get_row
+from .batch import _find_numpy
+from .lazy import LazyDecodedMessage
+from .decode_cache import DecodeCache
+from .record import create_record_type
+from .record import create_tuple_type
 
 from ..utils import format_or
 from ..utils import start_bit
+from ..utils import intern_string
 from ..utils import encode_data
 from ..utils import decode_data
 from ..utils import create_encode_decode_formats
@@ -15,6 +34,45 @@ from ..errors import EncodeError
 from ..errors import DecodeError
 
 
+class _Codec(dict):
+    """A codec node of signals, bitstruct formats and multiplexers. The
+    formats are created on first use, as most messages are encoded and
+    decoded with generated code not using them.
+
+    """
+
+    __slots__ = ('_length', )
+
+    def __init__(self, signals, multiplexers, length):
+        super(_Codec, self).__init__(signals=signals,
+                                     multiplexers=multiplexers)
+        self._length = length
+
+    def __missing__(self, key):
+        if key != 'formats':
+            raise KeyError(key)
+
+        return self._create_formats()
+
+    def _create_formats(self):
+        formats = create_encode_decode_formats(self['signals'], self._length)
+        self['formats'] = formats
+
+        return formats
+
+    def precompile(self):
+        """Create the formats of this node and all nodes below it.
+
+        """
+
+        if 'formats' not in self:
+            self._create_formats()
+
+        for multiplexer in self['multiplexers'].values():
+            for child in multiplexer.values():
+                child.precompile()
+
+
 class Message(object):
     """A CAN message with frame id, comment, signals and other
     information.
@@ -24,6 +82,40 @@ class Message(object):
 
     """
 
+    __slots__ = (
+        '_frame_id',
+        '_is_extended_frame',
+        '_name',
+        '_length',
+        '_signals',
+        '_comments',
+        '_senders',
+        '_send_type',
+        '_cycle_time',
+        '_dbc',
+        '_bus_name',
+        '_signal_groups',
+        '_codec_tree',
+        '_decoder',
+        '_encoder',
+        '_tuple_decoder',
+        '_record_decoder',
+        '_tuple_type',
+        '_record_type',
+        '_selected_decoders',
+        '_values_encoders',
+        '_decode_cache',
+        '_signal_tree',
+        '_strict',
+        '_protocol',
+        '_codec_module',
+        '_codec_module_choices',
+        '_signal_dict',
+        '_dirty',
+        '_refreshed_signals',
+        '_refreshed_strict'
+    )
+
     def __init__(self,
                  frame_id,
                  name,
@@ -53,7 +145,7 @@ class Message(object):
 
         self._frame_id = frame_id
         self._is_extended_frame = is_extended_frame
-        self._name = name
+        self._name = intern_string(name)
         self._length = length
         self._signals = signals
         self._signals.sort(key=start_bit)
@@ -70,46 +162,84 @@ class Message(object):
             # multi-lingual dictionary
             self._comments = comment
 
-        self._senders = senders if senders else []
+        self._senders = [
+            intern_string(sender) for sender in senders
+        ] if senders else []
         self._send_type = send_type
         self._cycle_time = cycle_time
         self._dbc = dbc_specifics
         self._bus_name = bus_name
         self._signal_groups = signal_groups
-        self._codecs = None
+        self._codec_tree = None
+        self._decoder = None
+        self._encoder = None
+        self._tuple_decoder = None
+        self._record_decoder = None
+        self._tuple_type = None
+        self._record_type = None
+        self._selected_decoders = None
+        self._values_encoders = None
+        self._decode_cache = None
         self._signal_tree = None
         self._strict = strict
         self._protocol = protocol
+        self._codec_module = None
+        self._codec_module_choices = None
+        self._signal_dict = None
+        self._dirty = True
+        self._refreshed_signals = None
+        self._refreshed_strict = None
         self.refresh()
 
-    def _create_codec(self, parent_signal=None, multiplexer_id=None):
+    def _index_signals(self):
+        """Returns signals by parent signal name and multiplexer id, and
+        multiplexer ids by parent signal name.
+
+        """
+
+        branches = {}
+        children_ids = {}
+
+        for signal in self._signals:
+            parent_signal = signal.multiplexer_signal
+
+            if parent_signal is None:
+                branches.setdefault((None, None), []).append(signal)
+                continue
+
+            multiplexer_ids = signal.multiplexer_ids or []
+            children_ids.setdefault(parent_signal, []).extend(multiplexer_ids)
+
+            for multiplexer_id in dict.fromkeys(multiplexer_ids):
+                key = (parent_signal, multiplexer_id)
+                branches.setdefault(key, []).append(signal)
+
+        return branches, children_ids
+
+    def _create_codec(self,
+                      parent_signal=None,
+                      multiplexer_id=None,
+                      index=None):
         """Create a codec of all signals with given parent signal. This is a
         recursive function.
 
         """
 
-        signals = []
-        multiplexers = {}
+        if index is None:
+            index = self._index_signals()
+
+        branches, children_ids = index
 
         # Find all signals matching given parent signal name and given
         # multiplexer id. Root signals' parent and multiplexer id are
         # both None.
-        for signal in self._signals:
-            if signal.multiplexer_signal != parent_signal:
-                continue
-
-            if ((multiplexer_id is not None)
-                and (multiplexer_id not in signal.multiplexer_ids)):
-                continue
+        signals = list(branches.get((parent_signal, multiplexer_id), []))
+        multiplexers = {}
 
+        for signal in signals:
             if signal.is_multiplexer:
-                children_ids = set()
-
-                for s in self._signals:
-                    if s.multiplexer_signal != signal.name:
-                        continue
-
-                    children_ids.update(s.multiplexer_ids)
+                multiplexer_ids = set()
+                multiplexer_ids.update(children_ids.get(signal.name, []))
 
                 # Some CAN messages will have muxes containing only
                 # the multiplexer and no additional signals. At Tesla
@@ -118,24 +248,17 @@ class Message(object):
                 # multiplexer is included, even if it has no child
                 # signals.
                 if signal.choices:
-                    children_ids.update(signal.choices.keys())
+                    multiplexer_ids.update(signal.choices.keys())
 
-                for child_id in children_ids:
-                    codec = self._create_codec(signal.name, child_id)
+                for child_id in multiplexer_ids:
+                    codec = self._create_codec(signal.name, child_id, index)
 
                     if signal.name not in multiplexers:
                         multiplexers[signal.name] = {}
 
                     multiplexers[signal.name][child_id] = codec
 
-            signals.append(signal)
-
-        return {
-            'signals': signals,
-            'formats': create_encode_decode_formats(signals,
-                                                    self._length),
-            'multiplexers': multiplexers
-        }
+        return _Codec(signals, multiplexers, self._length)
 
     def _create_signal_tree(self, codec):
         """Create a multiplexing tree node of given codec. This is a recursive
@@ -162,6 +285,13 @@ class Message(object):
 
         return nodes
 
+    @property
+    def _codecs(self):
+        if self._codec_tree is None:
+            self._codec_tree = self._create_codec()
+
+        return self._codec_tree
+
     @property
     def frame_id(self):
         """The message frame id.
@@ -173,6 +303,7 @@ class Message(object):
     @frame_id.setter
     def frame_id(self, value):
         self._frame_id = value
+        self._modified()
 
     @property
     def is_extended_frame(self):
@@ -185,6 +316,7 @@ class Message(object):
     @is_extended_frame.setter
     def is_extended_frame(self, value):
         self._is_extended_frame = value
+        self._modified()
 
     @property
     def name(self):
@@ -196,7 +328,8 @@ class Message(object):
 
     @name.setter
     def name(self, value):
-        self._name = value
+        self._name = intern_string(value)
+        self._modified()
 
     @property
     def length(self):
@@ -209,6 +342,7 @@ class Message(object):
     @length.setter
     def length(self, value):
         self._length = value
+        self._modified()
 
     @property
     def signals(self):
@@ -321,6 +455,20 @@ class Message(object):
     def protocol(self, value):
         self._protocol = value
 
+    @property
+    def codec_module(self):
+        """The compiled extension module used to decode this message, or
+        ``None`` if decoded in Python. See
+        :meth:`Database.register_codec()<cantools.database.can.Database.register_codec()>`.
+
+        """
+
+        return self._codec_module
+
+    @codec_module.setter
+    def codec_module(self, value):
+        self._codec_module = value
+
     @property
     def signal_tree(self):
         """All signal names and multiplexer ids as a tree. Multiplexer signals
@@ -335,6 +483,9 @@ class Message(object):
 
         """
 
+        if self._signal_tree is None:
+            self._signal_tree = self._create_signal_tree(self._codecs)
+
         return self._signal_tree
 
     def _get_mux_number(self, decoded, signal_name):
@@ -429,6 +580,16 @@ class Message(object):
 
         """
 
+        if self._encoder is not None:
+            try:
+                return self._encoder(data, scaling, padding, strict)
+            except Exception:
+                # Let the generic encoder raise the proper error.
+                pass
+
+        return self._encode_generic(data, scaling, padding, strict)
+
+    def _encode_generic(self, data, scaling, padding, strict):
         encoded, padding_mask = self._encode(self._codecs,
                                              data,
                                              scaling,
@@ -442,6 +603,158 @@ class Message(object):
 
         return binascii.unhexlify(encoded)[:self._length]
 
+    def encoder(self, scaling=True, padding=False, strict=True):
+        """Returns a function encoding signal values given as positional
+        arguments, in the order of :attr:`signals`, as a message of
+        this type. `scaling`, `padding` and `strict` are the same as
+        for :meth:`encode()`, but given once here instead of in each
+        call.
+
+        Values of signals in multiplexer branches not selected are
+        ignored, for example ``None``.
+
+        >>> foo = db.get_message_by_name('Foo')
+        >>> [signal.name for signal in foo.signals]
+        ['Bar', 'Fum']
+        >>> encode = foo.encoder()
+        >>> encode(1, 5.0)
+        b'\\x01\\x45\\x23\\x00\\x11'
+
+        """
+
+        key = (scaling, padding, strict)
+
+        if self._values_encoders is None:
+            self._values_encoders = {}
+
+        try:
+            return self._values_encoders[key]
+        except KeyError:
+            pass
+
+        def encode_generic(values):
+            if len(values) != len(self._signals):
+                raise EncodeError(
+                    "Expected {} signal values in message '{}', but "
+                    "got {}.".format(len(self._signals),
+                                     self._name,
+                                     len(values)))
+
+            data = {
+                signal.name: value
+                for signal, value in zip(self._signals, values)
+            }
+
+            return self._encode_generic(data, scaling, padding, strict)
+
+        encode = generate_values_encoder(
+            self._codecs,
+            self._name,
+            self._length,
+            [signal.name for signal in self._signals],
+            scaling,
+            padding,
+            strict,
+            encode_generic)
+
+        if encode is None:
+            # Not supported by the generated encoder.
+            def encode(*values):
+                return encode_generic(values)
+
+        self._values_encoders[key] = encode
+
+        return encode
+
+    def encode_values(self, *values, scaling=True, padding=False, strict=True):
+        """Encode given signal values, in the order of :attr:`signals`, as
+        a message of this type. This is the same as calling the
+        function returned by :meth:`encoder()`.
+
+        >>> foo = db.get_message_by_name('Foo')
+        >>> foo.encode_values(1, 5.0)
+        b'\\x01\\x45\\x23\\x00\\x11'
+
+        """
+
+        return self.encoder(scaling, padding, strict)(*values)
+
+    def encode_batch(self,
+                     columns,
+                     scaling=True,
+                     padding=False,
+                     strict=True,
+                     join=False):
+        """Encode given columns of signal values as messages of this type,
+        one message per row. Returns a list of bytes objects, or all
+        messages joined into one bytes object if `join` is ``True``.
+
+        `columns` is a dictionary of signal name and sequence of
+        values entries, for example lists or NumPy arrays, all of the
+        same length. A sequence of dictionaries as given to
+        :meth:`encode()` is accepted as well.
+
+        Multiplexed messages are encoded with the signals selected by
+        the multiplexer columns in each row. Values of signals not
+        selected in a row are ignored.
+
+        Ranges are validated once per column, and NumPy is used if
+        installed. The messages and the exceptions raised are the same
+        as if encoding one row at a time with :meth:`encode()`.
+
+        `scaling`, `padding` and `strict` are the same as for
+        :meth:`encode()`.
+
+        >>> foo = db.get_message_by_name('Foo')
+        >>> foo.encode_batch({'Bar': [1, 2], 'Fum': [5.0, 5.0]})
+        [b'\\x01\\x45\\x23\\x00\\x11', b'\\x02\\x45\\x23\\x00\\x11']
+
+        """
+
+        if isinstance(columns, Mapping):
+            rows = None
+            count = count_rows(columns)
+        else:
+            rows = columns
+            count = len(rows)
+            columns = {
+                signal.name: [row.get(signal.name) for row in rows]
+                for signal in self._signals
+            }
+
+        try:
+            encoded = encode_batch(self._codecs,
+                                   self._length,
+                                   columns,
+                                   count,
+                                   scaling,
+                                   padding,
+                                   strict,
+                                   join,
+                                   _find_numpy())
+        except RowError as e:
+            if rows is None:
+                row = get_row(columns, e.row)
+            else:
+                row = rows[e.row]
+
+            # Let the encoder raise the proper error.
+            self.encode(row, scaling, padding, strict)
+            encoded = None
+
+        if encoded is None:
+            # Not supported in batches, encode one row at a time.
+            if rows is None:
+                rows = [get_row(columns, row) for row in range(count)]
+
+            encoded = [self.encode(row, scaling, padding, strict)
+                       for row in rows]
+
+            if join:
+                encoded = b''.join(encoded)
+
+        return encoded
+
     def _decode(self, node, data, decode_choices, scaling):
         decoded = decode_data(data,
                               node['signals'],
@@ -468,25 +781,382 @@ class Message(object):
 
         return decoded
 
-    def decode(self, data, decode_choices=True, scaling=True):
+    def decode(self,
+               data,
+               decode_choices=True,
+               scaling=True,
+               signals=None,
+               lazy=False,
+               as_tuple=False):
         """Decode given data as a message of this type.
 
+        `data` is any bytes-like object, for example :class:`bytes`,
+        :class:`bytearray`, or a :class:`memoryview` into a larger
+        buffer such as a memory mapped log file. It is not copied,
+        except by the decode cache and lazily decoded messages, as
+        they keep it.
+
         If `decode_choices` is ``False`` scaled values are not
         converted to choice strings (if available).
 
         If `scaling` is ``False`` no scaling of signals is performed.
 
+        If `signals` is not ``None``, only signals with names in it
+        are decoded. All multiplexers are still checked, so invalid
+        multiplexer ids raise :class:`DecodeError` just as if all
+        signals were decoded. Names of signals not in the message are
+        ignored.
+
+        If `lazy` is ``True`` a read-only
+        :class:`~cantools.database.can.LazyDecodedMessage` mapping is
+        returned instead of a dictionary. Its signals are decoded
+        when first accessed.
+
+        If `as_tuple` is ``True`` a named tuple of type
+        :attr:`.tuple_type` is returned instead of a dictionary, which
+        is faster to create. Signals not in the selected multiplexer
+        branches are ``None``. It cannot be combined with `signals`
+        or `lazy`, and the decode cache is not used.
+
         >>> foo = db.get_message_by_name('Foo')
         >>> foo.decode(b'\\x01\\x45\\x23\\x00\\x11')
         {'Bar': 1, 'Fum': 5.0}
+        >>> foo.decode(b'\\x01\\x45\\x23\\x00\\x11', signals={'Fum'})
+        {'Fum': 5.0}
 
         """
 
-        data = data[:self._length]
+        if as_tuple:
+            if signals is not None or lazy:
+                raise ValueError(
+                    'as_tuple cannot be combined with signals or lazy.')
+
+            return self._decode_tuple(data, decode_choices, scaling)
+
+        if signals is not None:
+            return self._decode_selected(data,
+                                         decode_choices,
+                                         scaling,
+                                         signals)
+
+        if lazy:
+            return self._decode_lazy(data, decode_choices, scaling)
+
+        if self._decode_cache is not None:
+            return self._decode_cached(data, decode_choices, scaling)
+
+        return self._decode_uncached(data, decode_choices, scaling)
+
+    def _decode_uncached(self, data, decode_choices, scaling):
+        if self._codec_module is not None:
+            return self._decode_codec_module(data, decode_choices, scaling)
+
+        if len(data) != self._length:
+            data = data[:self._length]
+
+        if self._decoder is not None and len(data) == self._length:
+            return self._decoder(data, decode_choices, scaling)
 
         return self._decode(self._codecs, data, decode_choices, scaling)
 
+    @property
+    def tuple_type(self):
+        """The named tuple type returned by :meth:`.decode()` if
+        `as_tuple` is ``True``. Its fields are the signals in the same
+        order as in :attr:`.signals`. Signal names that are not valid
+        field names are replaced by their positions, for example
+        ``_3``.
+
+        """
+
+        if self._tuple_type is None:
+            self._tuple_type = create_tuple_type(
+                self._name,
+                [signal.name for signal in self._signals])
+
+        return self._tuple_type
+
+    @property
+    def record_type(self):
+        """The record type decoded into by :meth:`.decode_into()`, a
+        class with one attribute per signal and ``__slots__``. The
+        attributes are named as the fields of :attr:`.tuple_type`.
+
+        >>> foo = db.get_message_by_name('Foo')
+        >>> record = foo.record_type()
+        >>> foo.decode_into(record, b'\\x01\\x45\\x23\\x00\\x11')
+        Foo(Bar=1, Fum=5.0)
+
+        """
+
+        if self._record_type is None:
+            self._record_type = create_record_type(self._name,
+                                                   self.tuple_type._fields)
+
+        return self._record_type
+
+    def decode_into(self, record, data, decode_choices=True, scaling=True):
+        """Decode given data as a message of this type into given record of
+        type :attr:`.record_type`, overwriting its attributes in
+        place, and return it. No dictionary is created, which
+        reduces the garbage created by long running decoding.
+
+        Signals not in the selected multiplexer branches are set to
+        ``None``. The record is partially overwritten if decoding
+        fails.
+
+        `decode_choices` and `scaling` are the same as in
+        :meth:`.decode()`.
+
+        """
+
+        if (type(record) is not self._record_type
+            and not isinstance(record, self.record_type)):
+            raise TypeError(
+                "Expected a record of message '{}', but got {}.".format(
+                    self._name,
+                    type(record).__name__))
+
+        if len(data) != self._length:
+            data = data[:self._length]
+
+        if (self._record_decoder is not None
+            and self._codec_module is None
+            and len(data) == self._length):
+            return self._record_decoder(record, data, decode_choices, scaling)
+
+        return self._decode_into_generic(record, data, decode_choices, scaling)
+
+    def _decode_into_generic(self, record, data, decode_choices, scaling):
+        decoded = self._decode_uncached(data, decode_choices, scaling)
+
+        for signal, field in zip(self._signals, record._fields):
+            setattr(record, field, decoded.get(signal.name))
+
+        return record
+
+    def _decode_tuple(self, data, decode_choices, scaling):
+        if len(data) != self._length:
+            data = data[:self._length]
+
+        if (self._tuple_decoder is not None
+            and self._codec_module is None
+            and len(data) == self._length):
+            return self._tuple_decoder(data, decode_choices, scaling)
+
+        return self._decode_tuple_generic(data, decode_choices, scaling)
+
+    def _decode_tuple_generic(self, data, decode_choices, scaling):
+        decoded = self._decode_uncached(data, decode_choices, scaling)
+
+        return self.tuple_type._make([decoded.get(signal.name)
+                                      for signal in self._signals])
+
+    def _decode_cached(self, data, decode_choices, scaling):
+        if type(data) is not bytes or len(data) != self._length:
+            data = bytes(data[:self._length])
+        key = (data, decode_choices, scaling)
+        decoded = self._decode_cache.get(key)
+
+        if decoded is None:
+            decoded = MappingProxyType(
+                self._decode_uncached(data, decode_choices, scaling))
+            self._decode_cache.put(key, decoded)
+
+        return decoded
+
+    @property
+    def decode_cache(self):
+        """The :class:`~cantools.database.can.DecodeCache` of this message,
+        or ``None`` if disabled.
+
+        """
+
+        return self._decode_cache
+
+    def enable_decode_cache(self, size=1):
+        """Cache at most `size` decoded messages, keyed by raw data and
+        decode options. By default only the last decoded message is
+        cached.
+
+        While the cache is enabled :meth:`.decode()` returns read-only
+        mappings, shared by all calls decoding the same data with the
+        same options. Calls with `signals` or `lazy` are not cached.
+
+        """
+
+        self._decode_cache = DecodeCache(size)
+
+    def disable_decode_cache(self):
+        """Disable the decode cache.
+
+        """
+
+        self._decode_cache = None
+
+    def _decode_lazy(self, data, decode_choices, scaling):
+        data = bytes(data[:self._length])
+
+        # Decode at once if the compiled decoders cannot be used.
+        if (self._codec_module is not None
+            or len(data) != self._length
+            or self._get_selected_decoder(frozenset()) is None):
+            return LazyDecodedMessage(self,
+                                      data,
+                                      decode_choices,
+                                      scaling,
+                                      self.decode(data,
+                                                  decode_choices,
+                                                  scaling))
+
+        return LazyDecodedMessage(self, data, decode_choices, scaling)
+
+    def _get_selected_decoder(self, signals):
+        """Returns the compiled decoder of given frozen set of signal
+        names, or ``None`` if the message layout is not supported.
+
+        """
+
+        if self._selected_decoders is None:
+            self._selected_decoders = {}
+
+        try:
+            return self._selected_decoders[signals]
+        except KeyError:
+            decoder = generate_decoder(self._codecs,
+                                       self._name,
+                                       self._length,
+                                       signals)
+            self._selected_decoders[signals] = decoder
+
+            return decoder
+
+    def _decode_selected(self, data, decode_choices, scaling, signals):
+        if not isinstance(signals, frozenset):
+            signals = frozenset(signals)
+
+        decoder = self._get_selected_decoder(signals)
+
+        if len(data) != self._length:
+            data = data[:self._length]
+
+        if (decoder is not None
+            and self._codec_module is None
+            and len(data) == self._length):
+            return decoder(data, decode_choices, scaling)
+
+        decoded = self.decode(data, decode_choices, scaling)
+
+        return {
+            name: value
+            for name, value in decoded.items()
+            if name in signals
+        }
+
+    def decode_batch(self, payloads, scaling=True):
+        """Decode given payloads `payloads`, all of this message type, at
+        once. Returns a dictionary of signal name and NumPy array
+        entries, one element per payload. Requires NumPy.
+
+        `payloads` is either a sequence of bytes objects, or a two
+        dimensional NumPy array of bytes with one row per payload.
+
+        Signals in multiplexed branches are returned as masked arrays,
+        masked in payloads where the branch is not selected. Choices
+        are not converted to strings.
+
+        If `scaling` is ``False`` no scaling of signals is performed.
+
+        >>> foo = db.get_message_by_name('Foo')
+        >>> foo.decode_batch([b'\\x01\\x45\\x23\\x00\\x11',
+        ...                   b'\\x02\\x45\\x23\\x00\\x11'])
+        {'Bar': array([1, 2], dtype=uint64), 'Fum': array([5., 5.])}
+
+        """
+
+        return decode_batch(self._codecs, self._length, payloads, scaling)
+
+    def _generate_decoder(self, data, decode_choices, scaling):
+        self._decoder = generate_decoder(self._codecs,
+                                         self._name,
+                                         self._length)
+
+        if self._decoder is None:
+            return self._decode(self._codecs, data, decode_choices, scaling)
+
+        return self._decoder(data, decode_choices, scaling)
+
+    def _generate_tuple_decoder(self, data, decode_choices, scaling):
+        self._tuple_decoder = generate_tuple_decoder(
+            self._codecs,
+            self._name,
+            self._length,
+            [signal.name for signal in self._signals],
+            self.tuple_type)
+
+        if self._tuple_decoder is None:
+            return self._decode_tuple_generic(data, decode_choices, scaling)
+
+        return self._tuple_decoder(data, decode_choices, scaling)
+
+    def _generate_record_decoder(self, record, data, decode_choices, scaling):
+        self._record_decoder = generate_record_decoder(
+            self._codecs,
+            self._name,
+            self._length,
+            {
+                signal.name: field
+                for signal, field in zip(self._signals,
+                                         self.record_type._fields)
+            })
+
+        if self._record_decoder is None:
+            return self._decode_into_generic(record,
+                                             data,
+                                             decode_choices,
+                                             scaling)
+
+        return self._record_decoder(record, data, decode_choices, scaling)
+
+    def _generate_encoder(self, data, scaling, padding, strict):
+        self._encoder = generate_encoder(self._codecs,
+                                         self._name,
+                                         self._length)
+
+        if self._encoder is None:
+            raise Error('Unsupported message layout.')
+
+        return self._encoder(data, scaling, padding, strict)
+
+    def _decode_codec_module(self, data, decode_choices, scaling):
+        if decode_choices:
+            if self._codec_module_choices is None:
+                self._codec_module_choices = {
+                    signal.name: signal.choices
+                    for signal in self._signals
+                    if signal.choices
+                }
+
+            choices = self._codec_module_choices
+        else:
+            choices = None
+
+        try:
+            return self._codec_module.decode(self._frame_id,
+                                             data,
+                                             scaling,
+                                             choices)
+        except ValueError as e:
+            raise DecodeError(str(e))
+
     def get_signal_by_name(self, name):
+        signal = self._signal_dict.get(name)
+
+        if signal is not None and signal.name == name:
+            return signal
+
+        # Signals added or renamed since the last refresh are not in
+        # the dictionary.
         for signal in self._signals:
             if signal.name == name:
                 return signal
@@ -563,6 +1233,85 @@ class Message(object):
                 if child_bit is not None:
                     message_bits[i] = child_bit
 
+    def _signal_tree_bits(self, signal_tree, used_bits, masks):
+        """Returns given used bits with the bits of all signals in given
+        signal tree added, or ``None`` if any signal does not fit in
+        the message or is overlapping other signals.
+
+        """
+
+        for node in signal_tree:
+            if isinstance(node, dict):
+                signal_name, children = list(node.items())[0]
+            else:
+                signal_name = node
+                children = None
+
+            mask = masks[signal_name]
+
+            if mask is None or used_bits & mask:
+                return None
+
+            used_bits |= mask
+
+            if children is not None:
+                branches_bits = used_bits
+
+                for child_tree in children.values():
+                    child_bits = self._signal_tree_bits(child_tree,
+                                                        used_bits,
+                                                        masks)
+
+                    if child_bits is None:
+                        return None
+
+                    branches_bits |= child_bits
+
+                used_bits = branches_bits
+
+        return used_bits
+
+    def _check_signals_overlap(self):
+        """Raise an error if any signal does not fit in the message or is
+        overlapping other signals.
+
+        """
+
+        masks = {}
+        message_length = 8 * self._length
+        is_multiplexed = False
+
+        for signal in self._signals:
+            if signal.multiplexer_signal is not None:
+                is_multiplexed = True
+
+            if signal.name in masks:
+                continue
+
+            if signal.byte_order == 'big_endian':
+                begin = start_bit(signal)
+            else:
+                begin = signal.start
+
+            if begin < 0 or begin + signal.length > message_length:
+                masks[signal.name] = None
+            else:
+                masks[signal.name] = _signal_mask(signal, self._length)
+
+        if is_multiplexed:
+            used_bits = self._signal_tree_bits(self.signal_tree, 0, masks)
+        else:
+            # All signals are in the root of the signal tree.
+            used_bits = self._signal_tree_bits(
+                [signal.name for signal in self._signals],
+                0,
+                masks)
+
+        if used_bits is None:
+            # Let the bit list based check raise the proper error.
+            message_bits = message_length * [None]
+            self._check_signal_tree(message_bits, self.signal_tree)
+
     def _check_signal_tree(self, message_bits, signal_tree):
         for signal_name in signal_tree:
             if isinstance(signal_name, dict):
@@ -592,15 +1341,85 @@ class Message(object):
         """
 
         self._check_signal_lengths()
-        self._codecs = self._create_codec()
-        self._signal_tree = self._create_signal_tree(self._codecs)
+        # The codecs, decoders and encoders are created on first use,
+        # or by precompile().
+        self._codec_tree = None
+        self._signal_tree = None
+        self._decoder = self._generate_decoder
+        self._encoder = self._generate_encoder
+        self._tuple_decoder = self._generate_tuple_decoder
+        self._record_decoder = self._generate_record_decoder
+        self._tuple_type = None
+        self._record_type = None
+        self._selected_decoders = None
+        self._values_encoders = None
+
+        if self._decode_cache is not None:
+            self._decode_cache.clear()
+
+        self._signal_dict = {}
+
+        for signal in self._signals:
+            self._signal_dict.setdefault(signal.name, signal)
+
+        self._codec_module_choices = None
 
         if strict is None:
             strict = self._strict
 
         if strict:
-            message_bits = 8 * self.length * [None]
-            self._check_signal_tree(message_bits, self.signal_tree)
+            self._check_signals_overlap()
+
+        if self._signals != self._refreshed_signals:
+            for signal in self._signals:
+                if self not in signal._messages:
+                    signal._messages += (self, )
+
+            self._refreshed_signals = list(self._signals)
+
+        self._refreshed_strict = strict
+        self._dirty = False
+
+    def _modified(self):
+        self._dirty = True
+
+    def is_refresh_needed(self, strict=None):
+        """Returns ``True`` if the message, or any of its signals, has been
+        modified since it was last refreshed, and ``False`` otherwise.
+        Modifications are tracked by the property setters and by
+        comparing the signals list to the one at the last refresh.
+
+        A message refreshed without the overlap checks also needs a
+        refresh if `strict` is ``True``.
+
+        """
+
+        if strict is None:
+            strict = self._strict
+
+        return (self._dirty
+                or self._signals != self._refreshed_signals
+                or (strict and not self._refreshed_strict))
+
+    def precompile(self):
+        """Create the codecs of this message, and generate its decoder and
+        encoder, now instead of on first encode or decode. Call this
+        after :meth:`refresh()` to avoid the delay of the first encode
+        and decode of the message.
+
+        """
+
+        self._codecs.precompile()
+
+        if self._decoder == self._generate_decoder:
+            self._decoder = generate_decoder(self._codecs,
+                                             self._name,
+                                             self._length)
+
+        if self._encoder == self._generate_encoder:
+            self._encoder = generate_encoder(self._codecs,
+                                             self._name,
+                                             self._length)
 
     def __repr__(self):
         return "message('{}', 0x{:x}, {}, {}, {})".format(
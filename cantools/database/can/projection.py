@@ -0,0 +1,71 @@
+# Decode selected signals of messages in a database.
+
+class Projection(object):
+    """Decodes only selected signals of messages in a database. The
+    multiplexer ids of all messages are still checked.
+
+    Use :meth:`Database.projection()<cantools.database.can.Database.projection()>`
+    to create a projection.
+
+    """
+
+    def __init__(self, database, signals):
+        self._database = database
+
+        if callable(signals):
+            self._is_selected = signals
+        else:
+            names = frozenset(signals)
+            self._is_selected = lambda message, signal: signal.name in names
+
+        self._signals = {}
+
+        # Create all decoders up front.
+        for message in database.messages:
+            self._get_signals(message)
+
+    def _get_signals(self, message):
+        try:
+            return self._signals[message.name]
+        except KeyError:
+            signals = frozenset(signal.name
+                                for signal in message.signals
+                                if self._is_selected(message, signal))
+            self._signals[message.name] = signals
+            message._get_selected_decoder(signals)
+
+            return signals
+
+    def signals(self, message_name):
+        """A set of the names of the selected signals in given message.
+
+        """
+
+        message = self._database.get_message_by_name(message_name)
+
+        return self._get_signals(message)
+
+    def decode_message(self,
+                       frame_id_or_name,
+                       data,
+                       decode_choices=True,
+                       scaling=True):
+        """Decode the selected signals in given signal data `data` as a
+        message of given frame id or name `frame_id_or_name`. Returns
+        a dictionary of signal name-value entries, empty if no signal
+        of the message is selected.
+
+        See :meth:`Database.decode_message()<cantools.database.can.Database.decode_message()>`
+        for the other arguments.
+
+        """
+
+        try:
+            message = self._database._frame_id_to_message[frame_id_or_name]
+        except KeyError:
+            message = self._database._name_to_message[frame_id_or_name]
+
+        return message.decode(data,
+                              decode_choices,
+                              scaling,
+                              self._get_signals(message))
@@ -0,0 +1,1245 @@
+# Generate specialized Python source code for messages.
+#
+# A decoder and an encoder are created per message and multiplexer
+# branch, with bit positions, masks, scales and offsets as constants,
+# and compiled with the builtin compile() function. Messages with
+# nested multiplexers get a decoder per path through the multiplexer
+# tree instead.
+
+import math
+import struct
+from decimal import Decimal
+
+from ..utils import format_or
+from ..utils import start_bit
+from ..errors import DecodeError
+from .signal import NamedSignalValue
+
+
+DECODE_FMT = '''\
+def decode(data, decode_choices=True, scaling=True):
+{body}
+    return decoded
+'''
+
+DECODE_INTO_FMT = '''\
+def decode_into(decoded, data, decode_choices=True, scaling=True):
+{body}
+    return decoded
+'''
+
+DECODE_TUPLE_FMT = '''\
+def decode_tuple(data, decode_choices=True, scaling=True):
+{body}
+    return tuple_new(tuple_type, ({values}))
+'''
+
+DECODE_MUX_FMT = '''\
+def {name}(be, le, decoded, decode_choices, scaling):
+{body}
+'''
+
+DECODE_PATH_FMT = '''\
+def {name}(be, le, decode_choices, scaling):
+{body}
+    return decoded
+'''
+
+ENCODE_FMT = '''\
+def encode(data, scaling=True, padding=False, strict=True):
+{body}
+    return encoded.to_bytes({length}, "big")
+'''
+
+ENCODE_VALUES_FMT = '''\
+def encode(*values):
+    try:
+        [{parameters}] = values
+{body}
+    except Exception:
+        return encode_generic(values)
+    return encoded.to_bytes({length}, "big")
+'''
+
+ENCODE_MUX_FMT = '''\
+def {name}({parameters}):
+{body}
+    return be, le, used
+'''
+
+# Multiplexed messages with more paths through the multiplexer tree
+# than this are decoded branch by branch instead.
+MAXIMUM_NUMBER_OF_PATHS = 256
+
+FLOAT_FORMATS = {
+    16: '>e',
+    32: '>f',
+    64: '>d'
+}
+
+
+def _is_integer(value):
+    return (isinstance(value, int)
+            or (isinstance(value, float) and value.is_integer()))
+
+
+def _divide(numerator, denominator):
+    """Integer division rounding half to even, as
+    ``Decimal.to_integral()`` does.
+
+    """
+
+    if denominator < 0:
+        numerator = -numerator
+        denominator = -denominator
+
+    quotient, remainder = divmod(numerator, denominator)
+
+    if 2 * remainder > denominator:
+        quotient += 1
+    elif 2 * remainder == denominator and quotient & 1:
+        quotient += 1
+
+    return quotient
+
+
+def _encode_decimal(value, offset, scale):
+    value = (Decimal(value) - Decimal(offset)) / Decimal(scale)
+
+    return int(value.to_integral())
+
+
+def _indent(lines, depth=1):
+    return ['    ' * depth + line for line in lines]
+
+
+class _Namespace(object):
+    """Constants referenced by name by the generated code.
+
+    """
+
+    def __init__(self):
+        self.globals = {
+            '__builtins__': __builtins__,
+            'from_bytes': int.from_bytes,
+            'DecodeError': DecodeError,
+            'divide': _divide,
+            'encode_decimal': _encode_decimal,
+            'NamedSignalValue': NamedSignalValue
+        }
+
+    def add(self, prefix, value):
+        name = '{}{}'.format(prefix, len(self.globals))
+        self.globals[name] = value
+
+        return name
+
+    def constant(self, value):
+        """Return given number as a literal if possible, otherwise as a
+        global name.
+
+        """
+
+        if type(value) in [int, float] and not math.isinf(value) \
+           and not math.isnan(value):
+            if value < 0:
+                return '({!r})'.format(value)
+            else:
+                return repr(value)
+        else:
+            return self.add('k', value)
+
+
+def _fits(node, length):
+    """Returns ``True`` if all signals in given codec node are
+    within the message and not overlapping signals of the same byte
+    order, as required by the generated code to give the same result
+    as the bitstruct based decoder.
+
+    """
+
+    format_length = 8 * length
+    intervals = {'big_endian': [], 'little_endian': []}
+
+    for signal in node['signals']:
+        if signal.is_float and signal.length not in FLOAT_FORMATS:
+            return False
+
+        if signal.byte_order == 'big_endian':
+            begin = start_bit(signal)
+        else:
+            begin = signal.start
+
+        if begin < 0 or begin + signal.length > format_length:
+            return False
+
+        intervals[signal.byte_order].append((begin, begin + signal.length))
+
+    for byte_order_intervals in intervals.values():
+        end = 0
+
+        for begin, stop in sorted(byte_order_intervals):
+            if begin < end:
+                return False
+
+            end = stop
+
+    return all(_fits(child, length)
+               for multiplexer in node['multiplexers'].values()
+               for child in multiplexer.values())
+
+
+def _uses_byte_order(node, byte_order):
+    if any(signal.byte_order == byte_order for signal in node['signals']):
+        return True
+
+    return any(_uses_byte_order(child, byte_order)
+               for multiplexer in node['multiplexers'].values()
+               for child in multiplexer.values())
+
+
+def _format_bits(signal, length):
+    """Returns an expression of given signal's bits as an unsigned
+    integer.
+
+    """
+
+    if signal.byte_order == 'big_endian':
+        shift = 8 * length - start_bit(signal) - signal.length
+        value = 'be'
+    else:
+        shift = signal.start
+        value = 'le'
+
+    if shift > 0:
+        value = '({} >> {})'.format(value, shift)
+
+    return '{} & 0x{:x}'.format(value, (1 << signal.length) - 1)
+
+
+def _format_unpack(signal, raw, length, namespace):
+    """Lines unpacking given signal's raw value into variable `raw`.
+
+    """
+
+    lines = ['{} = {}'.format(raw, _format_bits(signal, length))]
+
+    if signal.is_float:
+        unpack = namespace.add('unpack_float',
+                               struct.Struct(FLOAT_FORMATS[signal.length]).unpack)
+        lines.append('{} = {}({}.to_bytes({}, "big"))[0]'.format(
+            raw,
+            unpack,
+            raw,
+            signal.length // 8))
+    elif signal.is_signed:
+        lines += [
+            'if {} & 0x{:x}:'.format(raw, 1 << (signal.length - 1)),
+            '    {} -= 0x{:x}'.format(raw, 1 << signal.length)
+        ]
+
+    return lines
+
+
+def _format_scaled(signal, raw, namespace):
+    """Returns an expression of given signal's scaled value, the same as
+    the generic decoder's result.
+
+    """
+
+    if signal.is_float \
+       or not _is_integer(signal.scale) \
+       or not _is_integer(signal.offset):
+        return '{} * {} + {}'.format(namespace.constant(signal.scale),
+                                     raw,
+                                     namespace.constant(signal.offset))
+
+    scale = int(signal.scale)
+    offset = int(signal.offset)
+    expression = raw
+
+    if scale != 1:
+        expression += ' * {}'.format(namespace.constant(scale))
+
+    if offset != 0:
+        expression += ' + {}'.format(namespace.constant(offset))
+
+    return expression
+
+
+def _is_identity(signal):
+    """Returns ``True`` if given signal's scaled value is always its raw
+    value.
+
+    """
+
+    return (not signal.is_float
+            and _is_integer(signal.scale)
+            and _is_integer(signal.offset)
+            and int(signal.scale) == 1
+            and int(signal.offset) == 0)
+
+
+def _mux_numbers(signal):
+    """Returns given multiplexer's choice numbers, converted back from
+    choice strings the same way as Message._get_mux_number() does.
+
+    """
+
+    numbers = {}
+
+    for number, choice in (signal.choices or {}).items():
+        if isinstance(choice, (str, NamedSignalValue)):
+            numbers[number] = signal.choice_string_to_number(choice)
+        else:
+            numbers[number] = choice
+
+    return numbers
+
+
+def _is_raw_mux(signal):
+    """Returns ``True`` if given multiplexer selects branches by its raw
+    value, whatever `decode_choices` and `scaling` are.
+
+    """
+
+    return (_is_identity(signal)
+            and all(key == value for key, value in _mux_numbers(signal).items()))
+
+
+def _format_mux(signal,
+                raw,
+                multiplexer,
+                namespace,
+                functions,
+                names,
+                targets):
+    """Lines selecting and calling the decoder of given multiplexer's
+    branch.
+
+    """
+
+    children = []
+
+    for multiplexer_id, child in multiplexer.items():
+        name = namespace.add('decode_mux_', None)
+        functions.append(DECODE_MUX_FMT.format(
+            name=name,
+            body='\n'.join(_format_node(child,
+                                         namespace,
+                                         functions,
+                                         names,
+                                         targets=targets))))
+        children.append('{!r}: {}'.format(multiplexer_id, name))
+
+    children_name = namespace.add('children', None)
+    functions.append('{} = {{{}}}\n'.format(children_name, ', '.join(children)))
+    message = namespace.add(
+        'message',
+        'expected multiplexer id {}, but got '.format(format_or(multiplexer)))
+
+    if _is_raw_mux(signal):
+        lines = ['mux = {}'.format(raw)]
+    else:
+        numbers_name = namespace.add('numbers', _mux_numbers(signal))
+        lines = [
+            'if decode_choices and {} in {}:'.format(raw, numbers_name),
+            '    mux = {}[{}]'.format(numbers_name, raw),
+            'elif scaling:',
+            '    mux = {}'.format(_format_scaled(signal, raw, namespace)),
+            'else:',
+            '    mux = {}'.format(raw)
+        ]
+
+    lines += [
+        'child = {}.get(mux)'.format(children_name),
+        'if child is None:',
+        "    raise DecodeError({} + '{{}}'.format(mux))".format(message),
+        'child(be, le, decoded, decode_choices, scaling)'
+    ]
+
+    return lines
+
+
+def _format_node(node,
+                 namespace,
+                 functions,
+                 names,
+                 is_root=False,
+                 targets=None):
+    """Lines decoding given codec node's signals in `names`, or all
+    signals if `names` is ``None``. All multiplexers are decoded to
+    select their branches, so that unknown multiplexer ids raise the
+    same errors whatever signals are selected.
+
+    The signals are decoded into the dictionary `decoded`, or
+    assigned to the expressions in `targets`, by signal name, if not
+    ``None``.
+
+    """
+
+    def target(signal):
+        if targets is None:
+            return 'decoded[{!r}]'.format(signal.name)
+        else:
+            return targets[signal.name]
+
+    lines = []
+    raws = {}
+    length = namespace.globals['length']
+    multiplexers = [
+        signal
+        for signal in node['signals']
+        if signal.name in node['multiplexers']
+    ]
+
+    if names is None:
+        signals = node['signals']
+    else:
+        signals = [signal for signal in node['signals'] if signal.name in names]
+
+    for signal in node['signals']:
+        if signal in signals or signal in multiplexers:
+            raw = 'r{}'.format(len(raws))
+            raws[signal.name] = raw
+            lines += _format_unpack(signal, raw, length, namespace)
+
+    if is_root and targets is None:
+        scaled = ['decoded = {']
+        unscaled = ['decoded = {']
+
+        for signal in signals:
+            raw = raws[signal.name]
+            scaled.append('    {!r}: {},'.format(
+                signal.name,
+                _format_scaled(signal, raw, namespace)))
+            unscaled.append('    {!r}: {},'.format(signal.name, raw))
+
+        scaled.append('}')
+        unscaled.append('}')
+    else:
+        scaled = []
+        unscaled = []
+
+        for signal in signals:
+            raw = raws[signal.name]
+            scaled.append('{} = {}'.format(
+                target(signal),
+                _format_scaled(signal, raw, namespace)))
+            unscaled.append('{} = {}'.format(target(signal), raw))
+
+    if scaled == unscaled:
+        lines += scaled
+    else:
+        lines.append('if scaling:')
+        lines += _indent(scaled)
+        lines.append('else:')
+        lines += _indent(unscaled)
+
+    choices = []
+
+    for signal in signals:
+        if not signal.choices:
+            continue
+
+        raw = raws[signal.name]
+        name = namespace.add('choices', signal.choices)
+        choices += [
+            'if {} in {}:'.format(raw, name),
+            '    {} = {}[{}]'.format(target(signal), name, raw)
+        ]
+
+    if choices:
+        lines.append('if decode_choices:')
+        lines += _indent(choices)
+
+    for signal in multiplexers:
+        lines += _format_mux(signal,
+                             raws[signal.name],
+                             node['multiplexers'][signal.name],
+                             namespace,
+                             functions,
+                             names,
+                             targets)
+
+    if not lines:
+        lines.append('pass')
+
+    return _indent(lines)
+
+
+def _number_of_paths(node):
+    number_of_paths = 1
+
+    for multiplexer in node['multiplexers'].values():
+        number_of_paths *= sum(_number_of_paths(child)
+                               for child in multiplexer.values())
+
+    return number_of_paths
+
+
+def _is_nested(node):
+    return any(child['multiplexers']
+               for multiplexer in node['multiplexers'].values()
+               for child in multiplexer.values())
+
+
+def _is_flattenable(node):
+    """Returns ``True`` if all multiplexers in given codec node select
+    branches by their raw values.
+
+    """
+
+    for signal in node['signals']:
+        if signal.name not in node['multiplexers']:
+            continue
+
+        if not _is_raw_mux(signal):
+            return False
+
+        if not all(_is_flattenable(child)
+                   for child in node['multiplexers'][signal.name].values()):
+            return False
+
+    return True
+
+
+def _mux_paths(node):
+    """Returns all paths through given codec node's multiplexer tree as
+    a list of multiplexer ids tuple, multiplexers list and signals
+    list triplets. The signals are in the same order as
+    decoded branch by branch.
+
+    """
+
+    paths = [((), [], list(node['signals']))]
+
+    for signal in node['signals']:
+        if signal.name not in node['multiplexers']:
+            continue
+
+        multiplexer = node['multiplexers'][signal.name]
+        paths = [
+            (key + (multiplexer_id,) + child_key,
+             multiplexers + [signal] + child_multiplexers,
+             signals + child_signals)
+            for key, multiplexers, signals in paths
+            for multiplexer_id, child in multiplexer.items()
+            for child_key, child_multiplexers, child_signals in _mux_paths(child)
+        ]
+
+    return paths
+
+
+def _node_multiplexers(node):
+    return [
+        (signal, node['multiplexers'][signal.name])
+        for signal in node['signals']
+        if signal.name in node['multiplexers']
+    ]
+
+
+def _unsigned(signal, value):
+    """Returns given multiplexer id as raw bits of given multiplexer
+    signal, or ``None`` if out of its range.
+
+    """
+
+    if signal.is_signed:
+        minimum = -(1 << (signal.length - 1))
+    else:
+        minimum = 0
+
+    if not minimum <= value < minimum + (1 << signal.length):
+        return None
+
+    return value & ((1 << signal.length) - 1)
+
+
+def _path_key(multiplexer_ids, multiplexers):
+    """Returns the key of given path through the multiplexer tree, the
+    raw bits of its multiplexers concatenated, or ``None`` if the
+    path is unreachable.
+
+    """
+
+    key = 0
+    shift = 0
+
+    for multiplexer_id, signal in zip(multiplexer_ids, multiplexers):
+        value = _unsigned(signal, multiplexer_id)
+
+        if value is None:
+            return None
+
+        key |= (value << shift)
+        shift += signal.length
+
+    return key
+
+
+def _format_mux_key(multiplexers, key, namespace, raws):
+    """Lines unpacking given multiplexers' raw bits, and the raw bits of
+    multiplexers in their selected branches, concatenated into the
+    integer `key`, as returned by _path_key().
+
+    `key` is a list of raw bits variables, their shifts and lengths.
+
+    """
+
+    if not multiplexers:
+        return ['key = ' + ' | '.join([
+            raw if shift == 0 else '({} << {})'.format(raw, shift)
+            for raw, shift, _ in key
+        ])]
+
+    signal, multiplexer = multiplexers[0]
+    multiplexers = multiplexers[1:]
+    raw = 'u{}'.format(len(raws))
+    raws.append(raw)
+
+    if key:
+        shift = key[-1][1] + key[-1][2]
+    else:
+        shift = 0
+
+    key = key + [(raw, shift, signal.length)]
+    lines = [
+        '{} = {}'.format(raw, _format_bits(signal, namespace.globals['length']))
+    ]
+    nested = [
+        (_unsigned(signal, multiplexer_id), child)
+        for multiplexer_id, child in multiplexer.items()
+        if child['multiplexers']
+    ]
+    nested = [(value, child) for value, child in nested if value is not None]
+
+    if not nested:
+        return lines + _format_mux_key(multiplexers, key, namespace, raws)
+
+    for i, (value, child) in enumerate(nested):
+        lines.append('{} {} == {}:'.format('if' if i == 0 else 'elif',
+                                           raw,
+                                           value))
+        lines += _indent(_format_mux_key(_node_multiplexers(child) + multiplexers,
+                                         key,
+                                         namespace,
+                                         raws))
+
+    lines.append('else:')
+    lines += _indent(_format_mux_key(multiplexers, key, namespace, raws))
+
+    return lines
+
+
+def _format_flattened(codecs, namespace, functions):
+    """Lines decoding given multiplexed message codecs in one pass. The
+    raw bits of the multiplexers select a decoder of all signals in
+    that path through the multiplexer tree.
+
+    """
+
+    paths = []
+
+    for multiplexer_ids, multiplexers, signals in _mux_paths(codecs):
+        key = _path_key(multiplexer_ids, multiplexers)
+
+        if key is None:
+            continue
+
+        name = namespace.add('decode_path_', None)
+        node = {'signals': signals, 'multiplexers': {}}
+        functions.append(DECODE_PATH_FMT.format(
+            name=name,
+            body='\n'.join(_format_node(node, namespace, functions, None, True))))
+        paths.append('{}: {}'.format(key, name))
+
+    paths_name = namespace.add('paths', None)
+    functions.append('{} = {{{}}}\n'.format(paths_name, ', '.join(paths)))
+
+    # Multiplexer values without a path are decoded branch by branch,
+    # raising the same error as the generic decoder.
+    branches_name = namespace.add('decode_branches_', None)
+    functions.append(DECODE_PATH_FMT.format(
+        name=branches_name,
+        body='\n'.join(_format_node(codecs, namespace, functions, None, True))))
+    lines = _format_mux_key(_node_multiplexers(codecs), [], namespace, [])
+    lines.append('decoded = {}.get(key, {})(be, le, decode_choices, scaling)'.format(
+        paths_name,
+        branches_name))
+
+    return _indent(lines)
+
+
+def _format_prologue(codecs):
+    """Lines converting the data into integers `be` and `le`.
+
+    """
+
+    lines = []
+    uses_big_endian = _uses_byte_order(codecs, 'big_endian')
+    uses_little_endian = _uses_byte_order(codecs, 'little_endian')
+
+    # from_bytes() copies other buffers than bytes, so copy only once
+    # if needed twice.
+    if uses_big_endian and uses_little_endian:
+        lines += [
+            'if type(data) is not bytes:',
+            '    data = bytes(data)'
+        ]
+
+    if uses_big_endian:
+        lines.append('be = from_bytes(data, "big")')
+    else:
+        lines.append('be = 0')
+
+    if uses_little_endian:
+        lines.append('le = from_bytes(data, "little")')
+    else:
+        lines.append('le = 0')
+
+    return _indent(lines)
+
+
+def _compile(functions, name, function_name, namespace):
+    source = '\n'.join(functions)
+    code = compile(source, '<decoder of message {}>'.format(name), 'exec')
+    exec(code, namespace.globals)
+    function = namespace.globals[function_name]
+    function.source = source
+
+    return function
+
+
+def generate_decoder(codecs, name, length, names=None):
+    """Returns a function decoding given message codecs, or ``None`` if
+    the message layout is not supported. The returned function takes
+    data of exactly `length` bytes, `decode_choices` and `scaling`
+    arguments, just as :meth:`Message.decode()`.
+
+    Only signals in `names` are decoded if not ``None``, but all
+    multiplexers select their branches, to raise errors for unknown
+    multiplexer ids.
+
+    """
+
+    if not _fits(codecs, length):
+        return None
+
+    namespace = _Namespace()
+    namespace.globals['length'] = length
+    functions = []
+    body = _format_prologue(codecs)
+
+    # Decode messages with nested multiplexers in one pass if
+    # possible. Branch by branch is as fast for a single level.
+    if (names is None
+        and _is_nested(codecs)
+        and _is_flattenable(codecs)
+        and _number_of_paths(codecs) <= MAXIMUM_NUMBER_OF_PATHS):
+        body += _format_flattened(codecs, namespace, functions)
+    else:
+        body += _format_node(codecs, namespace, functions, names, True)
+
+    functions.append(DECODE_FMT.format(body='\n'.join(body)))
+
+    return _compile(functions, name, 'decode', namespace)
+
+
+def generate_record_decoder(codecs, name, length, attributes):
+    """Returns a function decoding given message codecs into a record,
+    or ``None`` if the message layout is not supported. The returned
+    function takes the record, data of exactly `length` bytes,
+    `decode_choices` and `scaling` arguments, and returns the record.
+
+    Signals are assigned to the record attributes in `attributes`, by
+    signal name. Signals not in the selected multiplexer branches are
+    set to ``None``.
+
+    """
+
+    if not _fits(codecs, length):
+        return None
+
+    namespace = _Namespace()
+    namespace.globals['length'] = length
+    functions = []
+    body = _format_prologue(codecs)
+    targets = {
+        signal_name: 'decoded.{}'.format(attribute)
+        for signal_name, attribute in attributes.items()
+    }
+    root = set(signal.name for signal in codecs['signals'])
+    multiplexed = [
+        target
+        for signal_name, target in targets.items()
+        if signal_name not in root
+    ]
+
+    if multiplexed:
+        body += _indent([' = '.join(multiplexed) + ' = None'])
+
+    body += _format_node(codecs, namespace, functions, None, True, targets)
+    functions.append(DECODE_INTO_FMT.format(body='\n'.join(body)))
+
+    return _compile(functions, name, 'decode_into', namespace)
+
+
+def generate_tuple_decoder(codecs, name, length, names, tuple_type):
+    """Returns a function decoding given message codecs into an instance
+    of `tuple_type`, a named tuple of the signals in `names`, or
+    ``None`` if the message is multiplexed or its layout is not
+    supported. The returned function takes data of exactly `length`
+    bytes, `decode_choices` and `scaling` arguments.
+
+    """
+
+    if codecs['multiplexers'] or not _fits(codecs, length):
+        return None
+
+    namespace = _Namespace()
+    namespace.globals['length'] = length
+    namespace.globals['tuple_type'] = tuple_type
+    namespace.globals['tuple_new'] = tuple.__new__
+    functions = []
+    body = _format_prologue(codecs)
+    targets = {name: 'v{}'.format(i) for i, name in enumerate(names)}
+    body += _format_node(codecs, namespace, functions, None, True, targets)
+    functions.append(DECODE_TUPLE_FMT.format(
+        body='\n'.join(body),
+        values=''.join([target + ', ' for target in targets.values()])))
+
+    return _compile(functions, name, 'decode_tuple', namespace)
+
+
+def _signal_mask(signal, length):
+    """Returns the bits of given signal in the message as an integer
+    created from big endian bytes.
+
+    """
+
+    mask = (1 << signal.length) - 1
+
+    if signal.byte_order == 'big_endian':
+        return mask << (8 * length - start_bit(signal) - signal.length)
+    else:
+        mask <<= signal.start
+
+        return int.from_bytes(mask.to_bytes(length, 'little'), 'big')
+
+
+def _node_mask(node, length):
+    mask = 0
+
+    for signal in node['signals']:
+        mask |= _signal_mask(signal, length)
+
+    return mask
+
+
+def _float_bound(signal):
+    """Returns the largest magnitude of a value that is scaled with
+    floating point arithmetic with an error small enough to round it
+    the same way as with decimal arithmetic.
+
+    """
+
+    try:
+        return 5e-5 * abs(float(signal.scale)) * 2 ** 52 - abs(float(signal.offset))
+    except (TypeError, ValueError, OverflowError):
+        return 0.0
+
+
+class _EncoderOptions(object):
+    """How the generated encoder gets signal values, and if scaling and
+    strict are given when calling it (``None``) or when generating it.
+
+    """
+
+    def __init__(self, parameters, values, scaling=None, strict=None):
+        self.parameters = parameters
+        self.values = values
+        self.scaling = scaling
+        self.strict = strict
+
+    def value(self, signal):
+        """The expression of given signal's value.
+
+        """
+
+        if self.values is None:
+            return 'data[{!r}]'.format(signal.name)
+
+        return self.values[signal.name]
+
+
+def _format_check_range(signal, namespace, options):
+    """Lines raising an error if given value is outside given signal's
+    minimum and maximum in strict mode. The exception makes the caller
+    encode with the generic encoder, which raises the proper error.
+
+    """
+
+    if options.strict is False:
+        return []
+
+    conditions = []
+
+    if signal.minimum is not None:
+        conditions.append('v < {}'.format(namespace.constant(signal.minimum)))
+
+    if signal.maximum is not None:
+        conditions.append('v > {}'.format(namespace.constant(signal.maximum)))
+
+    if not conditions:
+        return []
+
+    if options.strict is None:
+        condition = 'strict and ({})'.format(' or '.join(conditions))
+    else:
+        condition = ' or '.join(conditions)
+
+    return [
+        'if {}:'.format(condition),
+        '    raise ValueError'
+    ]
+
+
+def _format_encode_scaled(signal, choices, namespace, options):
+    """Lines scaling value `v` of given signal into raw value `r`, the
+    same as the generic encoder.
+
+    """
+
+    check_range = _format_check_range(signal, namespace, options)
+    scale = namespace.constant(signal.scale)
+    offset = namespace.constant(signal.offset)
+
+    if signal.is_float:
+        lines = [
+            'if isinstance(v, (int, float)):'
+        ]
+        lines += _indent(check_range)
+        lines.append('    r = (v - {}) / {}'.format(offset, scale))
+    else:
+        scale_name = namespace.add('k', signal.scale)
+        offset_name = namespace.add('k', signal.offset)
+        float_lines = _indent(check_range) + [
+            '    if {} < v < {}:'.format(namespace.constant(-_float_bound(signal)),
+                                        namespace.constant(_float_bound(signal))),
+            '        q = (v - {}) / {}'.format(offset, scale),
+            '        r = round(q)',
+            '        if abs(q - r) > 0.4999:',
+            '            r = encode_decimal(v, {}, {})'.format(offset_name,
+                                                          scale_name),
+            '    else:',
+            '        r = encode_decimal(v, {}, {})'.format(offset_name,
+                                                       scale_name)
+        ]
+
+        if _is_integer(signal.scale) and _is_integer(signal.offset):
+            exact = 'v'
+
+            if int(signal.offset) != 0:
+                exact = 'v - {}'.format(namespace.constant(int(signal.offset)))
+
+            if int(signal.scale) != 1:
+                exact = 'divide({}, {})'.format(
+                    exact,
+                    namespace.constant(int(signal.scale)))
+
+            lines = ['if type(v) is int:']
+            lines += _indent(check_range)
+            lines.append('    r = {}'.format(exact))
+            lines.append('elif isinstance(v, float):')
+        else:
+            lines = ['if type(v) is int or isinstance(v, float):']
+
+        lines += float_lines
+
+    if choices is not None:
+        lines += [
+            'elif isinstance(v, str):',
+            '    r = {}[v]'.format(choices)
+        ]
+
+    lines += [
+        'else:',
+        '    raise TypeError'
+    ]
+
+    return lines
+
+
+def _format_encode_unscaled(signal, choices):
+    if signal.is_float:
+        lines = ['if isinstance(v, (int, float)):']
+    else:
+        lines = ['if type(v) is int:']
+
+    lines.append('    r = v')
+
+    if choices is not None:
+        lines += [
+            'elif isinstance(v, str):',
+            '    r = {}[v]'.format(choices)
+        ]
+
+    lines += [
+        'else:',
+        '    raise TypeError'
+    ]
+
+    return lines
+
+
+def _format_encode_signal(signal, length, namespace, options):
+    if signal.choices:
+        numbers = {}
+
+        # The first choice wins, as in Signal.choice_string_to_number().
+        for number, choice in signal.choices.items():
+            numbers.setdefault(str(choice), number)
+
+        choices = namespace.add('numbers', numbers)
+    else:
+        choices = None
+
+    lines = ['v = {}'.format(options.value(signal))]
+
+    if options.scaling is None:
+        lines.append('if scaling:')
+        lines += _indent(_format_encode_scaled(signal,
+                                               choices,
+                                               namespace,
+                                               options))
+        lines.append('else:')
+        lines += _indent(_format_encode_unscaled(signal, choices))
+    elif options.scaling:
+        lines += _format_encode_scaled(signal, choices, namespace, options)
+    else:
+        lines += _format_encode_unscaled(signal, choices)
+
+    if signal.byte_order == 'big_endian':
+        shift = 8 * length - start_bit(signal) - signal.length
+        value = 'be'
+    else:
+        shift = signal.start
+        value = 'le'
+
+    if signal.is_float:
+        pack = namespace.add('pack_float',
+                             struct.Struct(FLOAT_FORMATS[signal.length]).pack)
+        lines.append('r = from_bytes({}(r), "big")'.format(pack))
+    elif signal.is_signed:
+        minimum = -(1 << (signal.length - 1))
+        lines += [
+            'if not {} <= r <= {}:'.format(namespace.constant(minimum),
+                                           -minimum - 1),
+            '    raise ValueError',
+            'r &= 0x{:x}'.format((1 << signal.length) - 1)
+        ]
+    else:
+        lines += [
+            'if not 0 <= r <= {}:'.format((1 << signal.length) - 1),
+            '    raise ValueError'
+        ]
+
+    if shift > 0:
+        lines.append('{} |= r << {}'.format(value, shift))
+    else:
+        lines.append('{} |= r'.format(value))
+
+    return lines
+
+
+def _format_encode_mux(signal,
+                       multiplexer,
+                       length,
+                       namespace,
+                       functions,
+                       options):
+    """Lines selecting and calling the encoder of given multiplexer's
+    branch.
+
+    """
+
+    children = []
+
+    for multiplexer_id, child in multiplexer.items():
+        name = namespace.add('encode_mux_', None)
+        body = ['be = 0', 'le = 0', 'used = 0x{:x}'.format(
+            _node_mask(child, length))]
+        body = _indent(body)
+        body += _format_encode_node(child,
+                                    length,
+                                    namespace,
+                                    functions,
+                                    options)
+        functions.append(ENCODE_MUX_FMT.format(name=name,
+                                               parameters=options.parameters,
+                                               body='\n'.join(body)))
+        children.append('{!r}: {}'.format(multiplexer_id, name))
+
+    children_name = namespace.add('children', None)
+    functions.append('{} = {{{}}}\n'.format(children_name, ', '.join(children)))
+
+    # Choice strings are converted to numbers the same way as
+    # Message._get_mux_number() does.
+    if signal.choices:
+        numbers = {}
+
+        for number, choice in signal.choices.items():
+            numbers.setdefault(str(choice), number)
+    else:
+        numbers = {}
+
+    return [
+        'mux = {}'.format(options.value(signal)),
+        'if isinstance(mux, (str, NamedSignalValue)):',
+        '    mux = {}.get(str(mux))'.format(namespace.add('numbers', numbers)),
+        'mux_be, mux_le, mux_used = {}[mux]({})'.format(
+            children_name,
+            options.parameters),
+        'be |= mux_be',
+        'le |= mux_le',
+        'used |= mux_used'
+    ]
+
+
+def _format_encode_node(node, length, namespace, functions, options):
+    lines = []
+
+    for signal in node['signals']:
+        lines += _format_encode_signal(signal, length, namespace, options)
+
+    for signal in node['signals']:
+        if signal.name in node['multiplexers']:
+            lines += _format_encode_mux(signal,
+                                        node['multiplexers'][signal.name],
+                                        length,
+                                        namespace,
+                                        functions,
+                                        options)
+
+    return _indent(lines)
+
+
+def _format_encode_body(codecs, length, namespace, functions, options):
+    """Returns the lines encoding given message codecs into `encoded`,
+    and the expression of its unused bits.
+
+    """
+
+    message_mask = (1 << (8 * length)) - 1
+    body = ['be = 0', 'le = 0']
+
+    if codecs['multiplexers']:
+        body.append('used = 0x{:x}'.format(_node_mask(codecs, length)))
+
+    body = _indent(body)
+    body += _format_encode_node(codecs, length, namespace, functions, options)
+
+    if _uses_byte_order(codecs, 'little_endian'):
+        body.append('    encoded = be | from_bytes(le.to_bytes({}, "little"), '
+                    '"big")'.format(length))
+    else:
+        body.append('    encoded = be')
+
+    if codecs['multiplexers']:
+        padding = '0x{:x} & ~used'.format(message_mask)
+    else:
+        padding = '0x{:x}'.format(message_mask & ~_node_mask(codecs, length))
+
+    return body, padding
+
+
+def _compile_encoder(functions, name, namespace):
+    source = '\n'.join(functions)
+    code = compile(source, '<encoder of message {}>'.format(name), 'exec')
+    exec(code, namespace.globals)
+    encode = namespace.globals['encode']
+    encode.source = source
+
+    return encode
+
+
+def generate_encoder(codecs, name, length):
+    """Returns a function encoding given message codecs, or ``None`` if
+    the message layout is not supported. The returned function takes
+    the same arguments as :meth:`Message.encode()`.
+
+    The returned function raises an exception for all input the
+    generic encoder does not accept, but not necessarily the same
+    exception. Callers should encode with the generic encoder to get
+    the proper error.
+
+    """
+
+    if not _fits(codecs, length):
+        return None
+
+    namespace = _Namespace()
+    functions = []
+    options = _EncoderOptions('data, scaling, strict', None)
+    body, padding = _format_encode_body(codecs,
+                                        length,
+                                        namespace,
+                                        functions,
+                                        options)
+    body += [
+        '    if padding:',
+        '        encoded |= {}'.format(padding)
+    ]
+    functions.append(ENCODE_FMT.format(body='\n'.join(body), length=length))
+
+    return _compile_encoder(functions, name, namespace)
+
+
+def generate_values_encoder(codecs,
+                            name,
+                            length,
+                            signal_names,
+                            scaling,
+                            padding,
+                            strict,
+                            encode_generic):
+    """Returns a function encoding given message codecs from positional
+    signal values in the order of `signal_names`, with given scaling,
+    padding and strict, or ``None`` if the message layout is not
+    supported.
+
+    The returned function calls `encode_generic` with a tuple of the
+    values for all input it does not accept, including the wrong
+    number of values, to raise the proper error.
+
+    """
+
+    if not _fits(codecs, length):
+        return None
+
+    namespace = _Namespace()
+    functions = []
+    values = {
+        signal_name: 'a{}'.format(i)
+        for i, signal_name in enumerate(signal_names)
+    }
+    options = _EncoderOptions(', '.join(values.values()),
+                              values,
+                              scaling,
+                              strict)
+    body, padding_bits = _format_encode_body(codecs,
+                                             length,
+                                             namespace,
+                                             functions,
+                                             options)
+
+    if padding:
+        body.append('    encoded |= {}'.format(padding_bits))
+
+    namespace.globals['encode_generic'] = encode_generic
+    functions.append(ENCODE_VALUES_FMT.format(parameters=options.parameters,
+                                              body='\n'.join(_indent(body)),
+                                              length=length))
+
+    return _compile_encoder(functions, name, namespace)
@@ -0,0 +1,77 @@
+# Per message record types to decode signals into without creating
+# dictionaries.
+
+import keyword
+from collections import namedtuple
+
+
+class Record(object):
+    """Base class of the per message record types created by
+    :attr:`Message.record_type<cantools.database.can.Message.record_type>`.
+    A record has one attribute per signal, and is decoded into in
+    place by
+    :meth:`Message.decode_into()<cantools.database.can.Message.decode_into()>`.
+
+    All attributes are ``None`` when created.
+
+    """
+
+    __slots__ = ()
+    _fields = ()
+
+    # Records are mutable.
+    __hash__ = None
+
+    def __init__(self):
+        for field in self._fields:
+            setattr(self, field, None)
+
+    def _asdict(self):
+        """Returns a dictionary of field name and value entries.
+
+        """
+
+        return {field: getattr(self, field) for field in self._fields}
+
+    def __eq__(self, other):
+        if type(other) is not type(self):
+            return NotImplemented
+
+        return all(getattr(self, field) == getattr(other, field)
+                   for field in self._fields)
+
+    def __repr__(self):
+        return '{}({})'.format(
+            type(self).__name__,
+            ', '.join(['{}={!r}'.format(field, getattr(self, field))
+                       for field in self._fields]))
+
+
+def _type_name(name):
+    if name.isidentifier() and not keyword.iskeyword(name):
+        return name
+    else:
+        return 'Record'
+
+
+def create_tuple_type(name, signal_names):
+    """Returns a named tuple type with given signals as fields. Signal
+    names that are not valid field names are replaced by their
+    positions, for example ``_3``.
+
+    """
+
+    return namedtuple(_type_name(name), signal_names, rename=True)
+
+
+def create_record_type(name, fields):
+    """Returns a record type with given fields.
+
+    """
+
+    return type(_type_name(name),
+                (Record, ),
+                {
+                    '__slots__': tuple(fields),
+                    '_fields': tuple(fields)
+                })
@@ -1,5 +1,10 @@
 # A CAN signal.
 
+import weakref
+
+from ..utils import intern_string
+
+
 class Decimal(object):
     """Holds the same values as
     :attr:`~cantools.database.can.Signal.scale`,
@@ -11,11 +16,21 @@ class Decimal(object):
 
     """
 
+    __slots__ = (
+        '_scale',
+        '_offset',
+        '_minimum',
+        '_maximum',
+        '_signal'
+    )
+
     def __init__(self, scale=None, offset=None, minimum=None, maximum=None):
         self._scale = scale
         self._offset = offset
         self._minimum = minimum
         self._maximum = maximum
+        # The signal these values belong to.
+        self._signal = None
 
     @property
     def scale(self):
@@ -28,6 +43,7 @@ class Decimal(object):
     @scale.setter
     def scale(self, value):
         self._scale = value
+        self._modified()
 
     @property
     def offset(self):
@@ -40,6 +56,7 @@ class Decimal(object):
     @offset.setter
     def offset(self, value):
         self._offset = value
+        self._modified()
 
     @property
     def minimum(self):
@@ -53,6 +70,7 @@ class Decimal(object):
     @minimum.setter
     def minimum(self, value):
         self._minimum = value
+        self._modified()
 
     @property
     def maximum(self):
@@ -66,6 +84,12 @@ class Decimal(object):
     @maximum.setter
     def maximum(self, value):
         self._maximum = value
+        self._modified()
+
+    def _modified(self):
+        if self._signal is not None:
+            self._signal._modified()
+
 
 class NamedSignalValue(object):
     """Represents a named value of a signal.
@@ -75,8 +99,14 @@ class NamedSignalValue(object):
     descriptions for the named value.
     """
 
+    __slots__ = (
+        '_name',
+        '_value',
+        '_comments'
+    )
+
     def __init__(self, value, name, comments = {}):
-        self._name = name
+        self._name = intern_string(name)
         self._value = value
         self._comments = comments
 
@@ -131,6 +161,83 @@ class NamedSignalValue(object):
 
         return False
 
+class FrozenChoices(dict):
+    """A dictionary of signal choices that cannot be modified, as
+    signals with identical choices share one dictionary. Assign a new
+    dictionary to :attr:`Signal.choices
+    <cantools.database.can.Signal.choices>` to change the choices of
+    a signal.
+
+    """
+
+    __slots__ = ('__weakref__', )
+
+    def _modify(self, *args, **kwargs):
+        raise TypeError('Signal choices cannot be modified.')
+
+    __setitem__ = _modify
+    __delitem__ = _modify
+    __ior__ = _modify
+    clear = _modify
+    pop = _modify
+    popitem = _modify
+    setdefault = _modify
+    update = _modify
+
+    # Never modified, so copies share this dictionary.
+    def __copy__(self):
+        return self
+
+    def __deepcopy__(self, memo):
+        return self
+
+    def __reduce__(self):
+        return (type(self), (dict(self), ))
+
+
+# Choices by their contents, for sharing identical choices.
+_FROZEN_CHOICES = weakref.WeakValueDictionary()
+
+
+def _choice_key(number, choice):
+    if isinstance(choice, NamedSignalValue):
+        comments = choice.comments
+
+        if comments:
+            comments = tuple(comments.items())
+        else:
+            comments = None
+
+        return (number, choice.value, choice.name, comments)
+    else:
+        return (number, choice)
+
+
+def freeze_choices(choices):
+    """Returns given choices as a :class:`FrozenChoices` dictionary,
+    shared with all other signals with identical choices, or ``None``
+    if `choices` is ``None``.
+
+    """
+
+    if choices is None:
+        return None
+
+    try:
+        key = tuple([_choice_key(number, choice)
+                     for number, choice in choices.items()])
+        frozen_choices = _FROZEN_CHOICES.get(key)
+    except TypeError:
+        # Unhashable choices are not shared.
+        return FrozenChoices(choices)
+
+    if frozen_choices is None:
+        frozen_choices = FrozenChoices(choices)
+        _FROZEN_CHOICES[key] = frozen_choices
+
+    return frozen_choices
+
+
 class Signal(object):
     """A CAN signal with position, size, unit and other information. A
     signal is part of a message.
@@ -167,6 +274,31 @@ class Signal(object):
 
     """
 
+    __slots__ = (
+        '_name',
+        '_start',
+        '_length',
+        '_byte_order',
+        '_is_signed',
+        '_initial',
+        '_scale',
+        '_offset',
+        '_minimum',
+        '_maximum',
+        '_decimal',
+        '_unit',
+        '_choices',
+        '_dbc',
+        '_comments',
+        '_receivers',
+        '_is_multiplexer',
+        '_multiplexer_ids',
+        '_multiplexer_signal',
+        '_is_float',
+        '_spn',
+        '_messages'
+    )
+
     def __init__(self,
                  name,
                  start,
@@ -189,7 +321,7 @@ class Signal(object):
                  is_float=False,
                  decimal=None,
                  spn=None):
-        self._name = name
+        self._name = intern_string(name)
         self._start = start
         self._length = length
         self._byte_order = byte_order
@@ -200,8 +332,9 @@ class Signal(object):
         self._minimum = minimum
         self._maximum = maximum
         self._decimal = Decimal() if decimal is None else decimal
-        self._unit = unit
-        self._choices = choices
+        self._decimal._signal = self
+        self._unit = intern_string(unit)
+        self._choices = freeze_choices(choices)
         self._dbc = dbc_specifics
 
         # if the 'comment' argument is a string, we assume that is an
@@ -216,12 +349,17 @@ class Signal(object):
             # multi-lingual dictionary
             self._comments = comment
 
-        self._receivers = [] if receivers is None else receivers
+        self._receivers = [] if receivers is None else [
+            intern_string(receiver) for receiver in receivers
+        ]
         self._is_multiplexer = is_multiplexer
         self._multiplexer_ids = multiplexer_ids
         self._multiplexer_signal = multiplexer_signal
         self._is_float = is_float
         self._spn = spn
+        # The messages this signal is part of, added when the messages
+        # are refreshed. A signal is normally part of one message.
+        self._messages = ()
 
     @property
     def name(self):
@@ -233,7 +371,8 @@ class Signal(object):
 
     @name.setter
     def name(self, value):
-        self._name = value
+        self._name = intern_string(value)
+        self._modified()
 
     @property
     def start(self):
@@ -246,6 +385,7 @@ class Signal(object):
     @start.setter
     def start(self, value):
         self._start = value
+        self._modified()
 
     @property
     def length(self):
@@ -258,6 +398,7 @@ class Signal(object):
     @length.setter
     def length(self, value):
         self._length = value
+        self._modified()
 
     @property
     def byte_order(self):
@@ -270,6 +411,7 @@ class Signal(object):
     @byte_order.setter
     def byte_order(self, value):
         self._byte_order = value
+        self._modified()
 
     @property
     def is_signed(self):
@@ -284,6 +426,7 @@ class Signal(object):
     @is_signed.setter
     def is_signed(self, value):
         self._is_signed = value
+        self._modified()
 
     @property
     def is_float(self):
@@ -296,6 +439,7 @@ class Signal(object):
     @is_float.setter
     def is_float(self, value):
         self._is_float = value
+        self._modified()
 
     @property
     def initial(self):
@@ -320,6 +464,7 @@ class Signal(object):
     @scale.setter
     def scale(self, value):
         self._scale = value
+        self._modified()
 
     @property
     def offset(self):
@@ -332,6 +477,7 @@ class Signal(object):
     @offset.setter
     def offset(self, value):
         self._offset = value
+        self._modified()
 
     @property
     def minimum(self):
@@ -344,6 +490,7 @@ class Signal(object):
     @minimum.setter
     def minimum(self, value):
         self._minimum = value
+        self._modified()
 
     @property
     def maximum(self):
@@ -356,6 +503,7 @@ class Signal(object):
     @maximum.setter
     def maximum(self, value):
         self._maximum = value
+        self._modified()
 
     @property
     def decimal(self):
@@ -382,17 +530,24 @@ class Signal(object):
 
     @unit.setter
     def unit(self, value):
-        self._unit = value
+        self._unit = intern_string(value)
 
     @property
     def choices(self):
         """A dictionary mapping signal values to enumerated choices, or
-        ``None`` if unavailable.
+        ``None`` if unavailable. The dictionary cannot be modified, as
+        it is shared by all signals with identical choices, see
+        :class:`~cantools.database.can.signal.FrozenChoices`.
 
         """
 
         return self._choices
 
+    @choices.setter
+    def choices(self, value):
+        self._choices = freeze_choices(value)
+        self._modified()
+
     @property
     def dbc(self):
         """An object containing dbc specific properties like e.g. attributes.
@@ -456,6 +611,7 @@ class Signal(object):
     @is_multiplexer.setter
     def is_multiplexer(self, value):
         self._is_multiplexer = value
+        self._modified()
 
     @property
     def multiplexer_ids(self):
@@ -469,6 +625,7 @@ class Signal(object):
     @multiplexer_ids.setter
     def multiplexer_ids(self, value):
         self._multiplexer_ids = value
+        self._modified()
 
     @property
     def multiplexer_signal(self):
@@ -482,6 +639,7 @@ class Signal(object):
     @multiplexer_signal.setter
     def multiplexer_signal(self, value):
         self._multiplexer_signal = value
+        self._modified()
 
     @property
     def spn(self):
@@ -496,6 +654,16 @@ class Signal(object):
     def spn(self, value):
         self._spn = value
 
+    def _modified(self):
+        """Mark the messages this signal is part of as modified, so they
+        are refreshed by the next
+        :meth:`Database.refresh()<cantools.database.can.Database.refresh()>`.
+
+        """
+
+        for message in self._messages:
+            message._modified()
+
     def choice_string_to_number(self, string):
         for choice_number, choice_value in self.choices.items():
             if str(choice_value) == str(string):
@@ -1,5 +1,6 @@
 # Utility functions.
 
+import sys
 import binascii
 from decimal import Decimal
 from collections import namedtuple
@@ -38,6 +39,35 @@ def format_and(items):
                                   items[-1])
 
 
+def intern_string(value):
+    """Returns given value interned if it is a string, so that equal
+    names and units share one string object.
+
+    """
+
+    if type(value) is str:
+        return sys.intern(value)
+    else:
+        return value
+
+
+def is_scaled_int64(signal, scale, offset):
+    """Returns ``True`` if all raw values of given integer signal scaled
+    by given integer scale and offset fit in a signed 64 bits integer.
+
+    """
+
+    if signal.length > 63:
+        return False
+
+    if signal.is_signed:
+        maximum_raw = 2 ** (signal.length - 1)
+    else:
+        maximum_raw = 2 ** signal.length - 1
+
+    return maximum_raw * abs(scale) + abs(offset) < 2 ** 63
+
+
 def start_bit(data):
     if data.byte_order == 'big_endian':
         return (8 * (data.start // 8) + (7 - (data.start % 8)))
@@ -98,8 +128,10 @@ def encode_data(data, fields, formats, scaling):
 
 
 def decode_data(data, fields, formats, decode_choices, scaling):
-    unpacked = formats.big_endian.unpack(bytes(data))
-    unpacked.update(formats.little_endian.unpack(bytes(data[::-1])))
+    # No copy if already bytes.
+    data = bytes(data)
+    unpacked = formats.big_endian.unpack(data)
+    unpacked.update(formats.little_endian.unpack(data[::-1]))
 
     return {
         field.name: _decode_field(field,
@@ -1,6 +1,5 @@
 import re
 import enum
-import binascii
 import datetime
 
 
@@ -59,8 +58,7 @@ class CandumpDefaultPattern(BasePattern):
         channel = match_object.group('channel')
         frame_id = int(match_object.group('can_id'), 16)
         data = match_object.group('can_data')
-        data = data.replace(' ', '')
-        data = binascii.unhexlify(data)
+        data = bytes.fromhex(data)
         timestamp = None
         timestamp_format = TimestampFormat.MISSING
 
@@ -81,8 +79,7 @@ class CandumpTimestampedPattern(BasePattern):
         channel = match_object.group('channel')
         frame_id = int(match_object.group('can_id'), 16)
         data = match_object.group('can_data')
-        data = data.replace(' ', '')
-        data = binascii.unhexlify(data)
+        data = bytes.fromhex(data)
 
         seconds = float(match_object.group('timestamp'))
         if seconds < 662688000:  # 1991-01-01 00:00:00, "Released in 1991, the Mercedes-Benz W140 was the first production vehicle to feature a CAN-based multiplex wiring system."
@@ -106,8 +103,7 @@ class CandumpDefaultLogPattern(BasePattern):
         channel = match_object.group('channel')
         frame_id = int(match_object.group('can_id'), 16)
         data = match_object.group('can_data')
-        data = data.replace(' ', '')
-        data = binascii.unhexlify(data)
+        data = bytes.fromhex(data)
         timestamp = datetime.datetime.utcfromtimestamp(float(match_object.group('timestamp')))
         timestamp_format = TimestampFormat.ABSOLUTE
 
@@ -128,8 +124,7 @@ class CandumpAbsoluteLogPattern(BasePattern):
         channel = match_object.group('channel')
         frame_id = int(match_object.group('can_id'), 16)
         data = match_object.group('can_data')
-        data = data.replace(' ', '')
-        data = binascii.unhexlify(data)
+        data = bytes.fromhex(data)
         timestamp = datetime.datetime.strptime(match_object.group('timestamp'), "%Y-%m-%d %H:%M:%S.%f")
         timestamp_format = TimestampFormat.ABSOLUTE
 
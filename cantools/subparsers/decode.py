@@ -10,7 +10,9 @@ def _do_decode(args):
     dbase = database.load_file(args.database,
                                encoding=args.encoding,
                                frame_id_mask=args.frame_id_mask,
-                               strict=not args.no_strict)
+                               strict=not args.no_strict,
+                               cache_dir=args.cache_dir)
+    dbase.enable_decode_cache()
     decode_choices = not args.no_decode_choices
     parser = logreader.Parser(sys.stdin)
     for line, frame in parser.iterlines(keep_unknowns=True):
@@ -52,6 +54,10 @@ def add_subparser(subparsers):
         help=('Only compare selected frame id bits to find the message in the '
               'database. By default the candump and database frame ids must '
               'be equal for a match.'))
+    decode_parser.add_argument(
+        '--cache-dir',
+        help=('Database cache directory. Loading the same database again is '
+              'much faster when cached.'))
     decode_parser.add_argument(
         'database',
         help='Database file.')
@@ -1,9 +1,11 @@
 import argparse
 import os
 import os.path
+import sysconfig
 
 from .. import database
 from ..database.can.c_source import generate
+from ..database.can.c_source import generate_python_extension
 from ..database.can.c_source import camel_to_snake_case
 
 
@@ -31,7 +33,8 @@ def _do_generate_c_source(args):
         filename_c,
         fuzzer_filename_c,
         not args.no_floating_point_numbers,
-        args.bit_fields)
+        args.bit_fields,
+        args.jobs)
 
     os.makedirs(args.output_directory, exist_ok=True)
     
@@ -66,6 +69,31 @@ def _do_generate_c_source(args):
                 fuzzer_filename_mk))
         print('recent version of clang.')
 
+    if args.python_extension:
+        module_name = database_name + '_python'
+        python_filename_c = module_name + '.c'
+        python_source = generate_python_extension(dbase,
+                                                  database_name,
+                                                  filename_h,
+                                                  filename_c,
+                                                  python_filename_c,
+                                                  module_name)
+        python_path_c = os.path.join(args.output_directory, python_filename_c)
+
+        with open(python_path_c, 'w') as fout:
+            fout.write(python_source)
+
+        print('Successfully generated {}.'.format(python_path_c))
+        print()
+        print('Build the Python extension module with:')
+        print()
+        print('  cc -O2 -shared -fPIC -I{} {} {} -o {}{}'.format(
+            sysconfig.get_paths()['include'],
+            filename_c,
+            python_filename_c,
+            module_name,
+            sysconfig.get_config_var('EXT_SUFFIX')))
+
 
 def add_subparser(subparsers):
     generate_c_source_parser = subparsers.add_parser(
@@ -95,6 +123,17 @@ def add_subparser(subparsers):
         '-f', '--generate-fuzzer',
         action='store_true',
         help='Also generate fuzzer source code.')
+    generate_c_source_parser.add_argument(
+        '--python-extension',
+        action='store_true',
+        help=('Also generate a CPython extension module decoding messages with '
+              'the generated code.'))
+    generate_c_source_parser.add_argument(
+        '-j', '--jobs',
+        type=int,
+        default=1,
+        help=('Number of processes generating message code, or 0 for one per '
+              'CPU.'))
     generate_c_source_parser.add_argument(
         '-o', '--output-directory',
         default='.',
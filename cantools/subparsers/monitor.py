@@ -24,7 +24,9 @@ class Monitor(can.Listener):
         self._dbase = database.load_file(args.database,
                                          encoding=args.encoding,
                                          frame_id_mask=args.frame_id_mask,
-                                         strict=not args.no_strict)
+                                         strict=not args.no_strict,
+                                         cache_dir=args.cache_dir)
+        self._dbase.enable_decode_cache()
         self._single_line = args.single_line
         self._filtered_sorted_message_names = []
         self._filter = ''
@@ -484,6 +486,10 @@ def add_subparser(subparsers):
         '-f', '--fd',
         action='store_true',
         help='Python CAN CAN-FD bus.')
+    monitor_parser.add_argument(
+        '--cache-dir',
+        help=('Database cache directory. Loading the same database again is '
+              'much faster when cached.'))
     monitor_parser.add_argument(
         'database',
         help='Database file.')
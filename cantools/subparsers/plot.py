@@ -411,6 +411,9 @@ class Plotter:
         self.ignore_invalid_data = args.ignore_invalid_data
         self.output_filename = args.output_file
         self.signals = Signals(args.signals, args.case_sensitive, args.break_time, args, args.auto_color_ylabels)
+        # Only decode signals that are plotted.
+        self.projection = dbase.projection(
+            lambda message, signal: self.signals.is_displayed_signal(message.name + '.' + signal.name))
 
         self.x_invalid_syntax = []
         self.x_unknown_frames = []
@@ -429,7 +432,7 @@ class Plotter:
             return
 
         try:
-            decoded_signals = message.decode(data, self.decode_choices)
+            decoded_signals = self.projection.decode_message(message.name, data, self.decode_choices)
         except Exception as e:
             if self.show_invalid_data:
                 self.x_invalid_data.append(timestamp)
@@ -22,6 +22,8 @@ class DecodedMessage(object):
 
     """
 
+    __slots__ = ('name', 'signals')
+
     def __init__(self, name, signals):
         self.name = name
         self.signals = signals
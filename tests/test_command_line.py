@@ -5,6 +5,9 @@ import shutil
 import unittest
 import types
 import functools
+import subprocess
+import sysconfig
+import importlib.util
 
 try:
     from unittest.mock import patch
@@ -17,6 +20,7 @@ except ImportError:
     from io import StringIO
 
 import cantools
+from cantools.database.can import c_source
 
 
 def with_fake_screen_width(screen_width):
@@ -1224,6 +1228,27 @@ BATTERY_VT(
         db.add_dbc_file('test_command_line_convert.dbc')
         self.assertEqual(db.version, '1.0')
 
+        # DBC to CDB.
+        argv = [
+            'cantools',
+            'convert',
+            'tests/files/dbc/motohawk.dbc',
+            'test_command_line_convert.cdb'
+        ]
+
+        if os.path.exists('test_command_line_convert.cdb'):
+            os.remove('test_command_line_convert.cdb')
+
+        with patch('sys.argv', argv):
+            cantools._main()
+
+        db = cantools.database.load_file('test_command_line_convert.cdb')
+        self.assertEqual(db.version, '1.0')
+        self.assertEqual(
+            db.as_dbc_string(),
+            cantools.database.load_file(
+                'tests/files/dbc/motohawk.dbc').as_dbc_string())
+
     def test_convert_bad_outfile(self):
         argv = [
             'cantools',
@@ -1387,6 +1412,167 @@ BATTERY_VT(
         self.assert_files_equal(database_c,
                                 'tests/files/c_source/' + os.path.basename(database_c))
 
+    def test_generate_c_source_jobs(self):
+        databases = [
+            'vehicle',
+            'multiplex_2',
+            'abs'
+        ]
+
+        for database in databases:
+            for jobs, output_directory in [('1', 'jobs_1'), ('3', 'jobs_3')]:
+                argv = [
+                    'cantools',
+                    'generate_c_source',
+                    '--jobs', jobs,
+                    '--output-directory', output_directory,
+                    'tests/files/dbc/{}.dbc'.format(database)
+                ]
+
+                shutil.rmtree(output_directory, ignore_errors=True)
+
+                with patch('sys.argv', argv):
+                    cantools._main()
+
+            for extension in ['.h', '.c']:
+                filename = database + extension
+                self.assertEqual(read_file(os.path.join('jobs_3', filename)),
+                                 read_file(os.path.join('jobs_1', filename)))
+
+    def test_generate_c_source_python_extension(self):
+        compiler = shutil.which(sysconfig.get_config_var('CC').split()[0])
+        include_dir = sysconfig.get_paths()['include']
+
+        if compiler is None:
+            self.skipTest('no C compiler')
+
+        if not os.path.exists(os.path.join(include_dir, 'Python.h')):
+            self.skipTest('no Python headers')
+
+        output_directory = 'python_extension'
+        shutil.rmtree(output_directory, ignore_errors=True)
+        datas = [
+            b'\x00\x00\x00\x00\x00\x00\x00\x00',
+            b'\xff\xff\xff\xff\xff\xff\xff\xff',
+            b'\x01\x23\x45\x67\x89\xab\xcd\xef',
+            b'\xc0\x06\xe0\x00\x00\x00\x00\x00',
+            b'\x12\x34\x56'
+        ]
+
+        for database in ['motohawk', 'multiplex_2', 'multiplex_choices']:
+            argv = [
+                'cantools',
+                'generate_c_source',
+                '--python-extension',
+                '--output-directory', output_directory,
+                'tests/files/dbc/{}.dbc'.format(database)
+            ]
+
+            with patch('sys.argv', argv):
+                cantools._main()
+
+            module_name = database + '_python'
+            module_path = os.path.join(
+                output_directory,
+                module_name + sysconfig.get_config_var('EXT_SUFFIX'))
+            subprocess.check_call([
+                compiler,
+                '-O2',
+                '-shared',
+                '-fPIC',
+                '-I' + include_dir,
+                os.path.join(output_directory, database + '.c'),
+                os.path.join(output_directory, module_name + '.c'),
+                '-o', module_path
+            ])
+            spec = importlib.util.spec_from_file_location(module_name,
+                                                          module_path)
+            module = importlib.util.module_from_spec(spec)
+            spec.loader.exec_module(module)
+
+            filename = 'tests/files/dbc/{}.dbc'.format(database)
+            db = cantools.database.load_file(filename)
+            db_extension = cantools.database.load_file(filename)
+            registered = db_extension.register_codec(module)
+            self.assertEqual(len(registered), len(db.messages))
+
+            for message in db.messages:
+                message_extension = db_extension.get_message_by_name(
+                    message.name)
+                self.assertIs(message_extension.codec_module, module)
+
+                for data in datas:
+                    for decode_choices in [False, True]:
+                        for scaling in [False, True]:
+                            try:
+                                expected = message.decode(data,
+                                                          decode_choices,
+                                                          scaling)
+                            except cantools.database.DecodeError as e:
+                                with self.assertRaises(
+                                        cantools.database.DecodeError) as cm:
+                                    message_extension.decode(data,
+                                                             decode_choices,
+                                                             scaling)
+
+                                self.assertEqual(str(cm.exception), str(e))
+                                continue
+                            except Exception:
+                                with self.assertRaises(
+                                        cantools.database.DecodeError):
+                                    message_extension.decode(data,
+                                                             decode_choices,
+                                                             scaling)
+                                continue
+
+                            decoded = message_extension.decode(data,
+                                                               decode_choices,
+                                                               scaling)
+                            self.assertEqual(decoded, expected)
+                            self.assertEqual(list(decoded), list(expected))
+
+            frames = [
+                (message.frame_id, datas[2])
+                for message in db.messages
+                if not message.is_multiplexed()
+            ]
+            self.assertEqual(module.decode_batch(frames, False),
+                             [db.decode_message(frame_id, data, False, False)
+                              for frame_id, data in frames])
+
+            db_extension.register_codec(None)
+
+            for message in db_extension.messages:
+                self.assertIsNone(message.codec_module)
+
+    def test_generate_c_source_python_extension_scaling(self):
+        # Scaled integer values are only calculated as long long if
+        # they cannot overflow it.
+        datas = [
+            (32, False, 2 ** 31 - 1, 2 ** 61, False),
+            (32, False, 2 ** 31 - 1, 2 ** 32 + 2 ** 31 - 2, True),
+            (32, False, 2 ** 31 - 1, 2 ** 32 + 2 ** 31 - 1, False),
+            (32, True, 2 ** 32 - 1, -(2 ** 31 - 1), True),
+            (32, True, 2 ** 32 - 1, 2 ** 31, False),
+            (32, True, 2 ** 32, 0, False),
+            (63, True, 1, 1, True),
+            (63, False, 1, 1, False),
+            (64, True, 2, 0, False)
+        ]
+
+        for length, is_signed, scale, offset, is_long_long in datas:
+            signal = c_source.Signal(
+                cantools.database.can.Signal('Foo',
+                                             0,
+                                             length,
+                                             is_signed=is_signed,
+                                             scale=scale,
+                                             offset=offset))
+            lines = c_source._format_python_extension_signal(signal)
+            self.assertEqual('LL * (long long)msg.foo' in lines[4],
+                             is_long_long,
+                             (length, is_signed, scale, offset))
+
     def test_generate_c_source_bit_fields(self):
         databases = [
             'motohawk',
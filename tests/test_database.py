@@ -7,19 +7,27 @@ from decimal import Decimal
 from collections import namedtuple
 import textparser
 import os
+import shutil
 import re
 
 import logging
 from xml.etree import ElementTree
 import timeit
+import tracemalloc
 
 try:
     from StringIO import StringIO
 except ImportError:
     from io import StringIO
 
+try:
+    from unittest.mock import patch
+except ImportError:
+    from mock import patch
+
 import cantools
 from cantools.database.can.formats import dbc
+from cantools.database.can.formats import arxml
 from cantools.database import UnsupportedDatabaseFormatError
 from cantools.database.can.signal import NamedSignalValue
   
@@ -855,6 +863,21 @@ class CanToolsDatabaseTest(unittest.TestCase):
 
         self.assertEqual(str(cm.exception), "'Fum'")
 
+        # Signals added or renamed without a refresh are found as
+        # well.
+        message.signals.append(cantools.db.Signal(name='Fum',
+                                                  start=40,
+                                                  length=8))
+        signal = message.get_signal_by_name('Fum')
+        self.assertEqual(signal.name, 'Fum')
+
+        message.get_signal_by_name('Bar').name = 'Fie'
+        signal = message.get_signal_by_name('Fie')
+        self.assertEqual(signal.name, 'Fie')
+
+        with self.assertRaises(KeyError):
+            message.get_signal_by_name('Bar')
+
     def test_cp1252_dbc(self):
         db = cantools.database.load_file('tests/files/dbc/cp1252.dbc')
 
@@ -2492,8 +2515,247 @@ class CanToolsDatabaseTest(unittest.TestCase):
 
         self.assertEqual(
             str(cm.exception),
-            "expected database format 'arxml', 'dbc', 'kcd', 'sym', 'cdd' or "
-            "None, but got 'bad'")
+            "expected database format 'arxml', 'dbc', 'kcd', 'sym', 'cdd', "
+            "'cdb' or None, but got 'bad'")
+
+    def test_load_file_cache(self):
+        cache_dir = 'test_database_cache'
+        filename = 'test_database_cache.dbc'
+        shutil.rmtree(cache_dir, ignore_errors=True)
+        shutil.copyfile('tests/files/dbc/foobar.dbc', filename)
+
+        def load(**kwargs):
+            before = cantools.database.cache_statistics()
+            db = cantools.database.load_file(filename,
+                                             cache_dir=cache_dir,
+                                             **kwargs)
+            after = cantools.database.cache_statistics()
+
+            self.assertEqual(len(db.messages), 5)
+            self.assertEqual(after.hits + after.misses,
+                             before.hits + before.misses + 1)
+
+            return after.hits == before.hits + 1
+
+        self.assertFalse(load())
+        self.assertTrue(load())
+        self.assertTrue(load(cache_check_mtime=False))
+
+        # Other load options are cached separately.
+        self.assertFalse(load(strict=False))
+        self.assertFalse(load(frame_id_mask=0xff))
+        self.assertFalse(load(encoding='utf-8'))
+        self.assertTrue(load(encoding='utf-8'))
+        self.assertFalse(load(nodes=['FOO', 'FIE']))
+        self.assertTrue(load(nodes=['FIE', 'FOO']))
+
+        # Modified file.
+        with open(filename, 'a') as fout:
+            fout.write('\n')
+
+        self.assertFalse(load())
+        self.assertTrue(load())
+
+        # Same contents as a cached file, but not its path, size and
+        # modification time.
+        shutil.copyfile('tests/files/dbc/foobar.dbc', filename)
+        self.assertTrue(load())
+
+        statistics = cantools.database.cache_statistics()
+        self.assertGreater(statistics.hit_time, 0)
+        self.assertGreater(statistics.miss_time, 0)
+
+        shutil.rmtree(cache_dir)
+        os.remove(filename)
+
+    def test_load_message_filters(self):
+        def names(db):
+            return [message.name for message in db.messages]
+
+        # DBC.
+        filename = 'tests/files/dbc/foobar.dbc'
+        db = cantools.database.load_file(filename, nodes=['FIE'])
+        self.assertEqual(names(db), ['FOOBAR'])
+        db = cantools.database.load_file(filename, nodes=['FUM'])
+        self.assertEqual(names(db), ['Bar', 'CanFd'])
+        db = cantools.database.load_file(filename,
+                                         nodes=['BAR'],
+                                         frame_ids=[0x12331, 780])
+        self.assertEqual(names(db), ['Fum', 'FOOBAR'])
+        db = cantools.database.load_file(filename, buses=['Foo'])
+        self.assertEqual(names(db), [])
+        self.assertEqual(len(db.nodes), 4)
+
+        # CDB.
+        db = cantools.database.load_string(
+            cantools.database.load_file(filename).as_cdb_string(),
+            frame_ids=[780])
+        self.assertEqual(names(db), ['FOOBAR'])
+
+        # KCD.
+        db = cantools.database.load_file('tests/files/kcd/the_homer.kcd',
+                                         buses=['Motor', 'Instrumentation'])
+        self.assertEqual(len(db.messages), 13)
+        self.assertEqual(len(db.buses), 3)
+        db = cantools.database.load_file('tests/files/kcd/the_homer.kcd',
+                                         frame_ids=[0xa, 0xb2])
+        self.assertEqual(names(db), ['Airbag', 'ABS'])
+
+        # SYM.
+        db = cantools.database.load_file('tests/files/sym/jopp-6.0.sym',
+                                         frame_ids=[0x9, 0x23])
+        self.assertEqual(names(db), ['Symbol1', 'Message2'])
+        db = cantools.database.load_file('tests/files/sym/jopp-6.0.sym',
+                                         buses=['Foo'])
+        self.assertEqual(names(db), [])
+
+        # ARXML, with CAN clusters as buses.
+        filename = 'tests/files/arxml/system-4.2.arxml'
+        db = cantools.database.load_file(filename,
+                                         buses=['Cluster0'],
+                                         frame_ids=[6, 100])
+        self.assertEqual(names(db), ['Message2', 'Message3'])
+        db = cantools.database.load_file(filename, buses=['Foo'])
+        self.assertEqual(names(db), [])
+        db = cantools.database.load_file(
+            'tests/files/arxml/ecu-extract-4.2.arxml',
+            buses=['Foo'])
+        self.assertEqual(names(db), [])
+
+        # One CAN bus out of two.
+        with open(filename) as fin:
+            string = fin.read()
+
+        string = string.replace(
+            '                    <CAN-FRAME-TRIGGERING UUID="87601843097fe48c02bd86fc2e627fda">',
+            """                  </FRAME-TRIGGERINGS>
+                </CAN-PHYSICAL-CHANNEL>
+              </PHYSICAL-CHANNELS>
+            </CAN-CLUSTER-CONDITIONAL>
+          </CAN-CLUSTER-VARIANTS>
+        </CAN-CLUSTER>
+        <CAN-CLUSTER>
+          <SHORT-NAME>Cluster1</SHORT-NAME>
+          <CAN-CLUSTER-VARIANTS>
+            <CAN-CLUSTER-CONDITIONAL>
+              <PHYSICAL-CHANNELS>
+                <CAN-PHYSICAL-CHANNEL>
+                  <SHORT-NAME>Pch1</SHORT-NAME>
+                  <FRAME-TRIGGERINGS>
+                    <CAN-FRAME-TRIGGERING>""")
+        db = cantools.database.load_string(string)
+        self.assertEqual(names(db),
+                         ['Message1', 'Message2', 'Message3', 'Message4'])
+        db = cantools.database.load_string(string, buses=['Cluster1'])
+        self.assertEqual(names(db), ['Message3', 'Message4'])
+
+        # ARXML senders and receivers are not loaded, so filtering by
+        # node is an error, raised before parsing.
+        for database_format in [None, 'arxml']:
+            with self.assertRaises(ValueError) as cm:
+                cantools.database.load_file(filename,
+                                            database_format,
+                                            nodes=['Foo'])
+
+            self.assertEqual(str(cm.exception),
+                             'ARXML files cannot be filtered by node.')
+
+    def test_load_files(self):
+        filenames = [
+            'tests/files/dbc/foobar.dbc',
+            'tests/files/kcd/the_homer.kcd',
+            'tests/files/arxml/system-4.2.arxml'
+        ]
+        dbs = []
+
+        for jobs in [1, 2]:
+            db = cantools.database.load_files(filenames, jobs=jobs)
+            self.assertEqual(len(db.messages), 5 + 33 + 4)
+            self.assertEqual(db.version, '2.0')
+            self.assertEqual(db.get_message_by_name('Foo').frame_id, 0x12330)
+            self.assertEqual(db.get_message_by_frame_id(0xa).name, 'Airbag')
+            dbs.append(db)
+
+        self.assertEqual(repr(dbs[0]), repr(dbs[1]))
+
+        # Conflicts between files are reported.
+        with self.assertLogs('cantools.database', level='WARNING') as cm:
+            db = cantools.database.load_files(
+                ['tests/files/dbc/foobar.dbc', 'tests/files/dbc/foobar.dbc'],
+                jobs=1,
+                frame_ids=[780])
+
+        self.assertEqual(len(db.messages), 2)
+        self.assertEqual(
+            cm.output[:2],
+            [
+                "WARNING:cantools.database:Message 'FOOBAR' in "
+                "'tests/files/dbc/foobar.dbc' has the same name as a message "
+                "in 'tests/files/dbc/foobar.dbc'.",
+                "WARNING:cantools.database:Message 'FOOBAR' in "
+                "'tests/files/dbc/foobar.dbc' has the same masked frame id "
+                "0x30c as a message in 'tests/files/dbc/foobar.dbc'."
+            ])
+
+        with self.assertRaises(ValueError):
+            cantools.database.load_files(['tests/files/cdd/example.cdd'])
+
+        # Load errors in worker processes are reraised.
+        filename = 'test_load_files_bad.dbc'
+
+        with open(filename, 'w') as fout:
+            fout.write('BO_ 1 Foo: 8 Bar\n SG_ Fie : bad\n')
+
+        try:
+            with self.assertRaises(UnsupportedDatabaseFormatError) as cm:
+                cantools.database.load_files(
+                    ['tests/files/dbc/foobar.dbc', filename],
+                    jobs=2)
+        finally:
+            os.remove(filename)
+
+        self.assertIn('DBC: "Invalid syntax', str(cm.exception))
+        self.assertIsNone(cm.exception.e_kcd)
+
+    def test_sniff_database_format(self):
+        filenames = [
+            ('tests/files/arxml/system-4.2.arxml', 'arxml'),
+            ('tests/files/dbc/foobar.dbc', 'dbc'),
+            ('tests/files/kcd/the_homer.kcd', 'kcd'),
+            ('tests/files/sym/jopp-6.0.sym', 'sym'),
+            ('tests/files/cdd/example.cdd', 'cdd')
+        ]
+
+        for filename, database_format in filenames:
+            with open(filename, 'r', encoding='utf-8', errors='replace') as fin:
+                string = fin.read()
+
+            self.assertEqual(
+                cantools.database._sniff_database_format(string),
+                database_format)
+            db = cantools.database.load_string(string)
+
+            if database_format == 'cdd':
+                self.assertGreater(len(db.dids), 0)
+            else:
+                self.assertGreater(len(db.messages), 0)
+
+        datas = [
+            '',
+            'abc',
+            '<WrongRootElement/>',
+            b'\x00\x01'
+        ]
+
+        for data in datas:
+            self.assertIsNone(cantools.database._sniff_database_format(data))
+
+        # All formats are tried if the sniffed format fails to load.
+        with self.assertRaises(UnsupportedDatabaseFormatError) as cm:
+            cantools.database.load_string('VERSION ""\nBO_ 1 Foo 8 Bar\n')
+
+        self.assertTrue(str(cm.exception).startswith('ARXML: "'))
+        self.assertIn('CDD: "', str(cm.exception))
 
     def test_load_file_encoding(self):
         # Override default encoding.
@@ -2898,6 +3160,228 @@ class CanToolsDatabaseTest(unittest.TestCase):
 
         self.assertEqual(cm.exception.args[0], 0x41)
 
+    def test_memory_report(self):
+        db = cantools.db.load_file('tests/files/dbc/vehicle.dbc')
+        report = db.memory_report()
+
+        self.assertEqual(list(report),
+                         [
+                             'index',
+                             'messages',
+                             'signals',
+                             'choices',
+                             'codecs',
+                             'dbc',
+                             'strings',
+                             'other',
+                             'total'
+                         ])
+        self.assertEqual(report['total'],
+                         sum([size
+                              for category, size in report.items()
+                              if category != 'total']))
+
+        for category in ['index', 'messages', 'signals', 'dbc', 'strings']:
+            self.assertGreater(report[category], 0)
+
+        # Codecs are created on first use.
+        db.precompile()
+        self.assertGreater(db.memory_report()['codecs'], report['codecs'])
+
+        # Lazily loaded DBC specifics of databases loaded from CDB are
+        # counted as DBC as well, not as part of messages and signals.
+        db = cantools.database.load_string(db.as_cdb_string())
+        report = db.memory_report()
+
+        for message in db.messages:
+            message.dbc = None
+
+            for signal in message.signals:
+                signal.dbc = None
+
+        report_without_dbc = db.memory_report()
+        self.assertEqual(report_without_dbc['messages'], report['messages'])
+        self.assertGreater(report['dbc'] - report_without_dbc['dbc'],
+                           0.9 * (report['total'] - report_without_dbc['total']))
+
+        # Objects have no per instance dictionary.
+        signal = db.messages[0].signals[0]
+
+        with self.assertRaises(AttributeError):
+            signal.foo = 1
+
+        with self.assertRaises(AttributeError):
+            db.messages[0].foo = 1
+
+        # Names and units are interned.
+        unit = ''.join(['k', 'm/h'])
+        other = cantools.db.Signal(''.join(['Sp', 'eed']), 0, 8, unit=unit)
+        self.assertIs(other.name, sys.intern('Speed'))
+        self.assertIs(other.unit, sys.intern('km/h'))
+
+    def test_shared_choices(self):
+        foo = cantools.db.Signal('Foo', 0, 8, choices={0: 'Off', 1: 'On'})
+        bar = cantools.db.Signal('Bar', 8, 8, choices={0: 'Off', 1: 'On'})
+        fie = cantools.db.Signal('Fie', 16, 8, choices={0: 'Off'})
+
+        self.assertIs(foo.choices, bar.choices)
+        self.assertIsNot(foo.choices, fie.choices)
+        self.assertEqual(foo.choices, {0: 'Off', 1: 'On'})
+
+        with self.assertRaises(TypeError):
+            foo.choices[2] = 'Error'
+
+        with self.assertRaises(TypeError):
+            foo.choices.update({2: 'Error'})
+
+        # Assign new choices to change them.
+        foo.choices = {0: 'Off', 1: 'On', 2: 'Error'}
+        self.assertEqual(bar.choices, {0: 'Off', 1: 'On'})
+        self.assertEqual(foo.choices[2], 'Error')
+
+        # Named values with different comments are not shared.
+        choices = [
+            {0: cantools.db.can.signal.NamedSignalValue(0, 'Off', {'EN': 'a'})},
+            {0: cantools.db.can.signal.NamedSignalValue(0, 'Off', {'EN': 'b'})}
+        ]
+        foo.choices, bar.choices = choices
+        self.assertIsNot(foo.choices, bar.choices)
+
+        # Loaded choices.
+        db = cantools.db.load_file('tests/files/dbc/vehicle.dbc')
+        choices = [
+            signal.choices
+            for message in db.messages
+            for signal in message.signals
+            if signal.choices
+        ]
+        self.assertLess(len(set([id(choice) for choice in choices])),
+                        len(choices))
+
+    def test_refresh_only_modified_messages(self):
+        db = cantools.db.load_file('tests/files/dbc/foobar.dbc')
+        foo = db.get_message_by_name('Foo')
+        fum = db.get_message_by_name('Fum')
+
+        for message in db.messages:
+            self.assertFalse(message.is_refresh_needed())
+
+        # Message setter.
+        foo.name = 'Foo2'
+        self.assertTrue(foo.is_refresh_needed())
+        self.assertFalse(fum.is_refresh_needed())
+
+        with patch.object(cantools.db.Message,
+                          'refresh',
+                          autospec=True,
+                          side_effect=cantools.db.Message.refresh) as refresh:
+            db.refresh()
+
+        self.assertEqual([call[0][0] for call in refresh.call_args_list],
+                         [foo])
+        self.assertFalse(foo.is_refresh_needed())
+        self.assertIs(db.get_message_by_name('Foo2'), foo)
+
+        # Signal setter and signals list modifications.
+        fum.signals[0].length = 10
+        self.assertTrue(fum.is_refresh_needed())
+        db.refresh()
+        self.assertFalse(fum.is_refresh_needed())
+        fum.signals.append(cantools.db.Signal('Fie', 24, 8))
+        self.assertTrue(fum.is_refresh_needed())
+        db.refresh()
+        self.assertEqual(fum.get_signal_by_name('Fie').start, 24)
+
+        # The overlap checks are run on messages loaded with strict
+        # disabled once they are part of a strict database.
+        message = cantools.db.Message(0x7ff,
+                                      'Overlapping',
+                                      1,
+                                      [
+                                          cantools.db.Signal('A', 0, 8),
+                                          cantools.db.Signal('B', 0, 8)
+                                      ],
+                                      strict=False)
+        self.assertFalse(message.is_refresh_needed())
+        self.assertTrue(message.is_refresh_needed(strict=True))
+        db.messages.append(message)
+
+        with self.assertRaises(cantools.db.Error):
+            db.refresh()
+
+        db.messages.remove(message)
+        db.refresh()
+
+        # Only the added messages are indexed when adding a file, and
+        # they are only refreshed when created.
+        with patch.object(cantools.db.Message,
+                          'refresh',
+                          autospec=True,
+                          side_effect=cantools.db.Message.refresh) as refresh:
+            db.add_dbc_file('tests/files/dbc/add_two_dbc_files_1.dbc')
+
+        self.assertEqual(refresh.call_count, 2)
+        self.assertIs(db.get_message_by_name('M1'), db.messages[-2])
+        self.assertIs(db.get_message_by_name('Foo2'), foo)
+
+        # High precision values.
+        fum.signals[1].decimal.scale = Decimal(1)
+        self.assertTrue(fum.is_refresh_needed())
+        db.refresh()
+        self.assertFalse(fum.is_refresh_needed())
+
+        # A signal in several messages marks all of them as modified.
+        shared = cantools.db.Signal('Shared', 0, 8)
+        first = cantools.db.Message(0x700, 'First', 8, [shared])
+        second = cantools.db.Message(0x701, 'Second', 8, [shared])
+        db.messages.extend([first, second])
+        db.refresh()
+        shared.length = 4
+        self.assertTrue(first.is_refresh_needed())
+        self.assertTrue(second.is_refresh_needed())
+        db.refresh()
+        self.assertEqual(first.decode(b'\xff' * 8), {'Shared': 15})
+        self.assertEqual(second.decode(b'\xff' * 8), {'Shared': 15})
+
+        # Modifications in place are only picked up by a forced
+        # refresh.
+        signal = cantools.db.Signal('A',
+                                    8,
+                                    8,
+                                    multiplexer_ids=[1],
+                                    multiplexer_signal='Mux')
+        muxed = cantools.db.Message(
+            0x702,
+            'Muxed',
+            8,
+            [
+                cantools.db.Signal('Mux', 0, 8, is_multiplexer=True),
+                signal
+            ])
+        db.messages.append(muxed)
+        db.refresh()
+        signal.multiplexer_ids.append(2)
+        self.assertFalse(muxed.is_refresh_needed())
+        db.refresh(force=True)
+        self.assertEqual(muxed.decode(b'\x02\x05' + 6 * b'\x00'),
+                         {'Mux': 2, 'A': 5})
+
+        # The database copies a given list of messages, so messages
+        # are added to its messages list.
+        messages = [foo]
+        db = cantools.db.Database(messages)
+        self.assertIsNot(db.messages, messages)
+        messages.append(fum)
+        db.refresh()
+        self.assertEqual(db.messages, [foo])
+        db.messages.append(fum)
+        db.refresh()
+        self.assertIs(db.get_message_by_name('Fum'), fum)
+
+        # The messages list of another database is not copied.
+        other = cantools.db.Database(db.messages)
+        self.assertIs(other.messages, db.messages)
+
     def test_missing_dbc_specifics(self):
         db = cantools.db.Database()
 
@@ -3214,6 +3698,45 @@ class CanToolsDatabaseTest(unittest.TestCase):
 
             self.assertEqual(str(cm.exception), expected_overlpping)
 
+    def test_strict_many_multiplexer_branches(self):
+        def create_signals(last_start):
+            signals = [cantools.db.Signal('Mux', 0, 8, is_multiplexer=True)]
+
+            for branch in range(256):
+                for i in range(31):
+                    start = 16 + 16 * i
+
+                    if branch == 255 and i == 30:
+                        start = last_start
+
+                    signals.append(
+                        cantools.db.Signal('S{}_{}'.format(branch, i),
+                                           start,
+                                           16,
+                                           multiplexer_ids=[branch],
+                                           multiplexer_signal='Mux'))
+
+            return signals
+
+        message = cantools.db.Message(1, 'M', 64, create_signals(496))
+        self.assertEqual(len(message.signal_tree[0]['Mux']), 256)
+
+        datas = [
+            (488, 'The signals S255_30 and S255_29 are overlapping in '
+                  'message M.'),
+            (4, 'The signals S255_30 and Mux are overlapping in message M.'),
+            (500, 'The signal S255_30 does not fit in message M.')
+        ]
+
+        for last_start, expected_error in datas:
+            with self.assertRaises(cantools.db.Error) as cm:
+                cantools.db.Message(1, 'M', 64, create_signals(last_start))
+
+            self.assertEqual(str(cm.exception), expected_error)
+
+        # Not checked if not strict.
+        cantools.db.Message(1, 'M', 64, create_signals(4), strict=False)
+
     def test_strict_load(self):
         filenames = [
             'tests/files/kcd/bad_message_length.kcd',
@@ -3297,6 +3820,145 @@ class CanToolsDatabaseTest(unittest.TestCase):
         with open(filename, 'r') as fin:
             self.assertEqual(db.as_kcd_string(), fin.read())
 
+    def test_dbc_fast_parser(self):
+        """The fast parser must create the same parse tree as the
+        textparser based parser for all DBC files.
+
+        """
+
+        directory = 'tests/files/dbc'
+
+        for filename in sorted(os.listdir(directory)):
+            if not filename.endswith('.dbc'):
+                continue
+
+            with open(os.path.join(directory, filename),
+                      encoding='cp1252',
+                      errors='replace') as fin:
+                string = fin.read()
+
+            self.assertEqual(dbc.FastParser().parse(string),
+                             dbc.Parser().parse(string),
+                             filename)
+
+        # Invalid strings are not parsed by the fast parser.
+        for string in ['', 'abc', 'VERSION "1.0"\nBO_ dssd\n']:
+            with self.assertRaises(ValueError):
+                dbc.FastParser().parse(string)
+
+    def test_cdb(self):
+        """Test dumping and loading the CDB format.
+
+        """
+
+        filenames = [
+            'tests/files/dbc/vehicle.dbc',
+            'tests/files/dbc/foobar.dbc',
+            'tests/files/dbc/multiplex_2.dbc',
+            'tests/files/dbc/attributes.dbc',
+            'tests/files/kcd/the_homer.kcd',
+            'tests/files/arxml/system-4.2.arxml',
+            'tests/files/sym/jopp-6.0.sym'
+        ]
+        signal_attributes = [
+            'name', 'start', 'length', 'byte_order', 'is_signed', 'initial',
+            'scale', 'offset', 'minimum', 'maximum', 'unit', 'choices',
+            'comments', 'receivers', 'is_multiplexer', 'multiplexer_ids',
+            'multiplexer_signal', 'is_float', 'spn'
+        ]
+
+        for filename in filenames:
+            db = cantools.database.load_file(filename)
+            data = db.as_cdb_string()
+            self.assertIsInstance(data, bytes)
+            cdb_db = cantools.database.load_string(data)
+            self.assertEqual(repr(cdb_db), repr(db))
+            self.assertEqual(cdb_db.version, db.version)
+            self.assertEqual(repr(cdb_db.buses), repr(db.buses))
+
+            for message, cdb_message in zip(db.messages, cdb_db.messages):
+                self.assertEqual(cdb_message.comments, message.comments)
+                self.assertEqual(cdb_message.senders, message.senders)
+                self.assertEqual(cdb_message.cycle_time, message.cycle_time)
+                self.assertEqual(cdb_message.send_type, message.send_type)
+                self.assertEqual(cdb_message.bus_name, message.bus_name)
+                self.assertEqual(cdb_message.signal_tree, message.signal_tree)
+
+                for signal, cdb_signal in zip(message.signals,
+                                              cdb_message.signals):
+                    for attribute in signal_attributes:
+                        self.assertEqual(getattr(cdb_signal, attribute),
+                                         getattr(signal, attribute))
+
+                    for attribute in ['scale', 'offset', 'minimum', 'maximum']:
+                        self.assertEqual(getattr(cdb_signal.decimal, attribute),
+                                         getattr(signal.decimal, attribute))
+
+            if filename.endswith('.dbc'):
+                self.assertEqual(cdb_db.as_dbc_string(), db.as_dbc_string())
+
+            self.assertEqual(cdb_db.as_cdb_string(), data)
+
+        # Load a file, and choices with comments.
+        filename = 'test_database_cdb.cdb'
+        arxml_db = cantools.database.load_file(
+            'tests/files/arxml/system-4.2.arxml')
+        cantools.database.dump_file(arxml_db, filename)
+        db = cantools.database.load_file(filename)
+        os.remove(filename)
+        signal = db.get_message_by_name('Message2').get_signal_by_name(
+            'signal4')
+        self.assertEqual(signal.choices[1].comments,
+                         {'EN': 'One Comment', 'DE': 'Ein Kommentar'})
+        self.assertIsNone(signal.choices[2].comments)
+        data = {
+            'signal6': 'zero',
+            'signal1': 3,
+            'signal5': 3.0
+        }
+        encoded = db.encode_message('Message1', data)
+        self.assertEqual(encoded, arxml_db.encode_message('Message1', data))
+        self.assertEqual(db.decode_message('Message1', encoded),
+                         arxml_db.decode_message('Message1', encoded))
+
+        # Strict loading.
+        db = cantools.database.load_file('tests/files/dbc/vehicle.dbc')
+        message = db.messages[0]
+        message.signals[1].start = message.signals[0].start
+        data = db.as_cdb_string()
+        cantools.database.load_string(data, strict=False)
+
+        with self.assertRaises(cantools.database.Error):
+            cantools.database.load_string(data)
+
+        # Bad data.
+        corrupt = bytearray(data)
+        corrupt[len(corrupt) // 2] ^= 0x10
+        datas = [
+            (b'\x89CDB\r\n\x1a\n\x03\x00\x00\x00',
+             'CDB: "Unsupported CDB format version 3, only version 2 is '
+             'supported."'),
+            (data[:-1], 'CDB: "Invalid CDB checksum."'),
+            (bytes(corrupt), 'CDB: "Invalid CDB checksum."'),
+            (data[:14], 'CDB: "CDB data is truncated."'),
+            (data[:10], 'CDB: "CDB data is truncated."'),
+            (cantools.database.can.formats.cdb._Writer().dump(
+                (None, (), (), ((1, 2), ), None)),
+             'CDB: "Invalid CDB object: not enough values to unpack '
+             '(expected 13, got 2)"')
+        ]
+
+        for data, message in datas:
+            with self.assertRaises(UnsupportedDatabaseFormatError) as cm:
+                cantools.database.load_string(data)
+
+            self.assertEqual(str(cm.exception), message)
+
+        with self.assertRaises(UnsupportedDatabaseFormatError) as cm:
+            cantools.database.load_string(b'CDB', 'cdb')
+
+        self.assertEqual(str(cm.exception), 'CDB: "Invalid CDB magic."')
+
     def test_issue_62(self):
         """Test issue 62.
 
@@ -4128,10 +4790,16 @@ class CanToolsDatabaseTest(unittest.TestCase):
         self.assertEqual(str(cm.exception),
                          "Encountered a a non-unique child node of type AR-PACKAGE which ought to be unique")
 
-        # test the reference cache
+        # test the reference index
         foo = loader._follow_arxml_reference(loader._root, "/CanFrame/Message1", "CAN-FRAME")
         bar = loader._follow_arxml_reference(loader._root, "/CanFrame/Message1", "CAN-FRAME")
         self.assertEqual(foo, bar)
+        self.assertEqual(foo.find('ns:SHORT-NAME', loader._xml_namespaces).text,
+                         'Message1')
+        self.assertIsNone(
+            loader._follow_arxml_reference(loader._root, "/CanFrame/Message1", "I-SIGNAL"))
+        self.assertIsNone(
+            loader._follow_arxml_reference(loader._root, "/CanFrame/Missing", "CAN-FRAME"))
 
         # test non-unique location while assuming that it is unique
         with self.assertRaises(ValueError) as cm:
@@ -4223,6 +4891,38 @@ class CanToolsDatabaseTest(unittest.TestCase):
             str(cm.exception),
             'ARXML: "No XML namespace specified or illegal root tag name \'{http://autosar.org/schema/r4.0}NOT-AUTOSAR\'"')
 
+    def test_arxml_load_incrementally(self):
+        """Loading an ARXML file incrementally drops unused package
+        elements, but gives the same database as loading a string.
+
+        """
+
+        filename = 'tests/files/arxml/system-4.2.arxml'
+
+        with open(filename, 'r') as fin:
+            string = fin.read()
+
+        root = arxml._parse_needed(StringIO(string))
+        tags = [
+            elem.tag.split('}')[1]
+            for elem in root.iter()
+            if elem.tag.endswith('}ELEMENTS')
+            for elem in elem
+        ]
+        self.assertIn('CAN-CLUSTER', tags)
+        self.assertNotIn('SYSTEM', tags)
+
+        db = cantools.db.load_file(filename)
+        db_string = cantools.db.load_string(string, 'arxml')
+
+        self.assertEqual(repr(db), repr(db_string))
+
+        # Errors are raised as when loading a string.
+        with self.assertRaises(UnsupportedDatabaseFormatError) as cm:
+            cantools.db.load(StringIO('<foo'), 'arxml')
+
+        self.assertTrue(str(cm.exception).startswith('ARXML: "'))
+
     def test_ecu_extract_arxml(self):
         db = cantools.database.Database()
         db.add_arxml_file('tests/files/arxml/ecu-extract-4.2.arxml')
@@ -4697,6 +5397,926 @@ class CanToolsDatabaseTest(unittest.TestCase):
         self.assertEqual(db.buses[0].comment, 'SpecialRelease')
         self.assert_dbc_dump(db, filename)
 
+    def test_compiled_decoder(self):
+        """The compiled decoder must give the same result as the generic
+        bitstruct based decoder.
+
+        """
+
+        filenames = [
+            'tests/files/dbc/vehicle.dbc',
+            'tests/files/dbc/motohawk.dbc',
+            'tests/files/dbc/multiplex_2.dbc',
+            'tests/files/dbc/multiplex_choices.dbc',
+            'tests/files/dbc/issue_184_extended_mux_cascaded.dbc',
+            'tests/files/dbc/issue_184_extended_mux_independent_multiplexors.dbc',
+            'tests/files/dbc/floating_point.dbc',
+            'tests/files/dbc/signed.dbc'
+        ]
+        datas = [
+            b'\x00\x00\x00\x00\x00\x00\x00\x00',
+            b'\xff\xff\xff\xff\xff\xff\xff\xff',
+            b'\x01\x23\x45\x67\x89\xab\xcd\xef',
+            b'\x3c\x11\xa0\x00\x7f\x80\x01\xfe'
+        ]
+
+        for filename in filenames:
+            db = cantools.database.load_file(filename)
+
+            for message in db.messages:
+                for data in datas:
+                    data = data[:message.length]
+
+                    for decode_choices in [False, True]:
+                        for scaling in [False, True]:
+                            try:
+                                expected = message._decode(message._codecs,
+                                                           data,
+                                                           decode_choices,
+                                                           scaling)
+                            except cantools.database.DecodeError as e:
+                                with self.assertRaises(
+                                        cantools.database.DecodeError) as cm:
+                                    message.decode(data,
+                                                   decode_choices,
+                                                   scaling)
+
+                                self.assertEqual(str(cm.exception), str(e))
+                                continue
+
+                            decoded = message.decode(data,
+                                                     decode_choices,
+                                                     scaling)
+                            # repr() as NaN is not equal to itself.
+                            self.assertEqual(repr(decoded), repr(expected))
+
+                # Generated on first use.
+                self.assertIsNotNone(message._decoder)
+                self.assertNotEqual(message._decoder,
+                                    message._generate_decoder)
+
+    def test_compiled_decoder_nested_multiplexers(self):
+        """Messages with nested multiplexers are decoded in one pass, with
+        the decoder of the path through the multiplexer tree selected
+        by the multiplexers' raw values.
+
+        """
+
+        db = cantools.database.load_file(
+            'tests/files/dbc/issue_184_extended_mux_cascaded.dbc')
+        message = db.get_message_by_name('ext_MUX_cascaded')
+        datas = [
+            (b'\x01\x02\x00\x00\x00\x00\x00\x00',
+             {'MUX_A': 1, 'muxed_A_1': 2}),
+            (b'\x02\x00\x03\x00\x00\x00\x00\x00',
+             {'MUX_A': 2, 'muxed_A_2_MUX_B': 0, 'muxed_B_0': 3}),
+            (b'\x02\x01\x00\xfc\x00\x00\x00\x00',
+             {'MUX_A': 2, 'muxed_A_2_MUX_B': 1, 'muxed_B_1': -4})
+        ]
+
+        for data, expected in datas:
+            decoded = message.decode(data)
+            self.assertEqual(decoded, expected)
+            self.assertEqual(list(decoded), list(expected))
+
+        self.assertIn('decode_path_', message._decoder.source)
+
+        # Multiplexer values without a branch.
+        datas = [
+            (b'\x00\x00\x00\x00\x00\x00\x00\x00',
+             'expected multiplexer id 1 or 2, but got 0'),
+            (b'\xff\x00\x00\x00\x00\x00\x00\x00',
+             'expected multiplexer id 1 or 2, but got -1'),
+            (b'\x02\x02\x00\x00\x00\x00\x00\x00',
+             'expected multiplexer id 0 or 1, but got 2')
+        ]
+
+        for data, message_string in datas:
+            with self.assertRaises(cantools.database.DecodeError) as cm:
+                message.decode(data)
+
+            self.assertEqual(str(cm.exception), message_string)
+
+    def test_compiled_encoder(self):
+        """The compiled encoder must give the same result as the generic
+        bitstruct and decimal based encoder, and the same errors.
+
+        """
+
+        db = cantools.database.load_file('tests/files/dbc/vehicle.dbc')
+        datas = [
+            b'\x00\x00\x00\x00\x00\x00\x00\x00',
+            b'\xff\xff\xff\xff\xff\xff\xff\xff',
+            b'\x01\x23\x45\x67\x89\xab\xcd\xef'
+        ]
+
+        for message in db.messages:
+            for data in datas:
+                decoded = message.decode(data[:message.length],
+                                         decode_choices=False)
+
+                for padding in [False, True]:
+                    expected = message._encode_generic(decoded,
+                                                       True,
+                                                       padding,
+                                                       False)
+                    encoded = message.encode(decoded,
+                                             padding=padding,
+                                             strict=False)
+                    self.assertEqual(encoded, expected)
+
+            self.assertNotEqual(message._encoder, message._generate_encoder)
+
+        # Values rounded half to even, as with decimal arithmetic.
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        message = db.get_message_by_name('ExampleMessage')
+
+        for temperature in [244.205, 244.215, 250.0, 270.47]:
+            data = {
+                'Temperature': temperature,
+                'AverageRadius': 0.25,
+                'Enable': 1
+            }
+            self.assertEqual(message.encode(data),
+                             message._encode_generic(data, True, False, True))
+
+        # Errors are raised by the generic encoder.
+        with self.assertRaises(cantools.database.EncodeError) as cm:
+            message.encode({'Temperature': 250.0, 'Enable': 1})
+
+        self.assertEqual(
+            str(cm.exception),
+            "Expected signal value for 'AverageRadius' in data, but got "
+            "{'Temperature': 250.0, 'Enable': 1}.")
+
+        with self.assertRaises(cantools.database.EncodeError) as cm:
+            message.encode({
+                'Temperature': 300.0,
+                'AverageRadius': 0.25,
+                'Enable': 1
+            })
+
+        self.assertEqual(
+            str(cm.exception),
+            "Expected signal 'Temperature' value less than or equal to "
+            "270.47 in message 'ExampleMessage', but got 300.0.")
+
+    def test_decode_selected_signals(self):
+        db = cantools.database.load_file('tests/files/dbc/multiplex_2.dbc')
+        message = db.get_message_by_name('Extended')
+        data = b'\x00\x11\x22\x33\x01\xff\xee\x00'
+        decoded = message.decode(data)
+
+        for signals in [{'S2'}, ['S2', 'S3'], {'S0', 'S7'}, {'S6'}, set()]:
+            self.assertEqual(message.decode(data, signals=signals),
+                             {
+                                 name: value
+                                 for name, value in decoded.items()
+                                 if name in signals
+                             })
+
+        # Signals in not selected branches are not decoded.
+        self.assertEqual(message.decode(data, signals={'S5', 'S8'}), {})
+        self.assertEqual(message.decode(data, signals={'Foo'}), {})
+
+        # All multiplexer ids are checked, also of multiplexers
+        # without selected signals.
+        data = b'\x02\x11\x22\x33\x01\xff\xee\x00'
+
+        for signals in [{'S2'}, {'S7'}, {'S6'}, set()]:
+            with self.assertRaises(cantools.database.DecodeError) as cm:
+                message.decode(data, signals=signals)
+
+            self.assertEqual(str(cm.exception),
+                             'expected multiplexer id 0 or 1, but got 2')
+
+        db = cantools.database.load_file('tests/files/dbc/abs.dbc')
+        message = db.get_message_by_name('BREMSE_52')
+        data = b'\x00\xa8\xd9\xa5\x37\xe7\x24\xc4'
+
+        for signals in [None, {'Mplx_SW_Info'}]:
+            with self.assertRaises(cantools.database.DecodeError) as cm:
+                message.decode(data, signals=signals)
+
+            self.assertEqual(str(cm.exception),
+                             'expected multiplexer id 1, 2, 3, 4, 5, 6 or 7, '
+                             'but got 0')
+
+        # Data shorter than the message.
+        with self.assertRaises(Exception):
+            message.decode(data[:4], signals={'Mplx_SW_Info'})
+
+    def test_decode_buffers(self):
+        """Decode from bytearrays and memoryviews into larger buffers.
+
+        """
+
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        message = db.get_message_by_name('ExampleMessage')
+        data = b'\xc0\x06\xe0\x00\x00\x00\x00\x00'
+        expected = message.decode(data)
+        buf = bytearray(b'\xff' * 3 + data + b'\xff' * 5)
+        view = memoryview(buf)
+        datas = [
+            bytearray(data),
+            memoryview(data),
+            view[3:11],
+            view[3:]
+        ]
+
+        for data in datas:
+            self.assertEqual(message.decode(data), expected)
+            self.assertEqual(message._decode(message._codecs,
+                                             data[:8],
+                                             True,
+                                             True),
+                             expected)
+            self.assertEqual(message.decode(data, signals={'Temperature'}),
+                             {'Temperature': 250.55})
+            self.assertEqual(dict(message.decode(data, lazy=True)), expected)
+            self.assertEqual(db.decode_message(496, data), expected)
+
+        # Lazily decoded messages keep a copy of the data.
+        decoded = message.decode(view[3:], lazy=True)
+        buf[3:11] = bytes(8)
+        self.assertEqual(decoded['Temperature'], 250.55)
+        self.assertEqual(message.decode(view[3:11])['Temperature'], 250.0)
+
+        # The decode cache keeps a copy as well.
+        message.enable_decode_cache()
+        self.assertEqual(message.decode(view[3:11])['Temperature'], 250.0)
+        buf[3:11] = datas[1]
+        self.assertEqual(message.decode(view[3:11]), expected)
+
+    def test_decode_as_tuple(self):
+        filenames = [
+            'tests/files/dbc/motohawk.dbc',
+            'tests/files/dbc/vehicle.dbc',
+            'tests/files/dbc/multiplex_choices.dbc',
+            'tests/files/dbc/issue_184_extended_mux_cascaded.dbc'
+        ]
+        datas = [
+            b'\x00\x00\x00\x00\x00\x00\x00\x00',
+            b'\x01\x23\x45\x67\x89\xab\xcd\xef',
+            b'\x02\x01\x00\xfc\x00\x00\x00\x00'
+        ]
+
+        for filename in filenames:
+            db = cantools.database.load_file(filename)
+
+            for message in db.messages:
+                names = [signal.name for signal in message.signals]
+                self.assertEqual(len(message.tuple_type._fields), len(names))
+
+                for data in datas:
+                    for decode_choices in [False, True]:
+                        try:
+                            decoded = message.decode(data, decode_choices)
+                        except cantools.database.DecodeError:
+                            with self.assertRaises(cantools.database.DecodeError):
+                                message.decode(data,
+                                               decode_choices,
+                                               as_tuple=True)
+
+                            continue
+
+                        expected = [decoded.get(name) for name in names]
+                        decoded = message.decode(data,
+                                                 decode_choices,
+                                                 as_tuple=True)
+                        self.assertIsInstance(decoded, message.tuple_type)
+                        self.assertEqual(list(decoded), expected)
+
+                        # Too long data.
+                        decoded = message.decode(data + b'\x00',
+                                                 decode_choices,
+                                                 as_tuple=True)
+                        self.assertEqual(list(decoded), expected)
+
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        message = db.get_message_by_name('ExampleMessage')
+        decoded = message.decode(b'\xc0\x06\xe0\x00\x00\x00\x00\x00',
+                                 as_tuple=True)
+        self.assertEqual(decoded.Enable, 'Enabled')
+        self.assertEqual(decoded.AverageRadius, 3.2)
+        self.assertEqual(decoded.Temperature, 250.55)
+        self.assertEqual(
+            repr(decoded),
+            'ExampleMessage(Enable=Enabled, AverageRadius=3.2, '
+            'Temperature=250.55)')
+
+        with self.assertRaises(ValueError) as cm:
+            message.decode(b'\x00' * 8, signals={'Enable'}, as_tuple=True)
+
+        self.assertEqual(str(cm.exception),
+                         'as_tuple cannot be combined with signals or lazy.')
+
+    def test_decode_into(self):
+        db = cantools.database.load_file(
+            'tests/files/dbc/issue_184_extended_mux_cascaded.dbc')
+        message = db.get_message_by_name('ext_MUX_cascaded')
+        record = message.record_type()
+        self.assertEqual(
+            repr(record),
+            'ext_MUX_cascaded(MUX_A=None, muxed_A_2_MUX_B=None, '
+            'muxed_A_1=None, muxed_B_0=None, muxed_B_1=None)')
+
+        decoded = message.decode_into(record,
+                                      b'\x02\x01\x00\xfc\x00\x00\x00\x00')
+        self.assertIs(decoded, record)
+        self.assertEqual(record._asdict(),
+                         {
+                             'MUX_A': 2,
+                             'muxed_A_2_MUX_B': 1,
+                             'muxed_A_1': None,
+                             'muxed_B_0': None,
+                             'muxed_B_1': -4
+                         })
+
+        # Signals in other multiplexer branches are overwritten by
+        # None.
+        message.decode_into(record, b'\x01\x02\x00\x00\x00\x00\x00\x00')
+        self.assertEqual(record._asdict(),
+                         {
+                             'MUX_A': 1,
+                             'muxed_A_2_MUX_B': None,
+                             'muxed_A_1': 2,
+                             'muxed_B_0': None,
+                             'muxed_B_1': None
+                         })
+
+        # Records are compared by value.
+        other = message.record_type()
+        self.assertNotEqual(record, other)
+        message.decode_into(other, b'\x01\x02\x00\x00\x00\x00\x00\x00')
+        self.assertEqual(record, other)
+
+        with self.assertRaises(cantools.database.DecodeError):
+            message.decode_into(record, b'\x00\x00\x00\x00\x00\x00\x00\x00')
+
+        # Records of other messages are not accepted.
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        message = db.get_message_by_name('ExampleMessage')
+
+        with self.assertRaises(TypeError) as cm:
+            message.decode_into(record, b'\x00' * 8)
+
+        self.assertEqual(
+            str(cm.exception),
+            "Expected a record of message 'ExampleMessage', but got "
+            "ext_MUX_cascaded.")
+
+        record = message.record_type()
+
+        for data in [b'\xc0\x06\xe0\x00\x00\x00\x00\x00',
+                     b'\xc0\x06\xe0\x00\x00\x00\x00\x00\xff']:
+            for decode_choices in [False, True]:
+                for scaling in [False, True]:
+                    message.decode_into(record, data, decode_choices, scaling)
+                    self.assertEqual(record._asdict(),
+                                     message.decode(data,
+                                                    decode_choices,
+                                                    scaling))
+
+        # A new record type after the signals are changed.
+        record_type = message.record_type
+        message.refresh()
+        self.assertIsNot(message.record_type, record_type)
+
+    def test_decode_records_memory(self):
+        """Replay frames through decode_into() and decode() with as_tuple,
+        and profile the traced memory.
+
+        """
+
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        message = db.get_message_by_name('ExampleMessage')
+        frames = [
+            message.encode({
+                'Enable': 1,
+                'AverageRadius': (i % 50) / 10,
+                'Temperature': 250 + (i % 100) / 100
+            })
+            for i in range(100)
+        ]
+        frames *= 100
+        record = message.record_type()
+
+        # Generate the decoders before tracing.
+        message.decode_into(record, frames[0])
+        message.decode(frames[0])
+        message.decode(frames[0], as_tuple=True)
+
+        def retained(decode):
+            tracemalloc.start()
+
+            try:
+                start, _ = tracemalloc.get_traced_memory()
+                decoded = decode()
+                current, peak = tracemalloc.get_traced_memory()
+            finally:
+                tracemalloc.stop()
+
+            return current - start, peak - start
+
+        def decode_into():
+            for data in frames:
+                message.decode_into(record, data)
+
+        # Decoding into a record does not allocate memory per frame,
+        # unlike decoding into dictionaries.
+        into_current, into_peak = retained(decode_into)
+        current, peak = retained(
+            lambda: [message.decode(data) for data in frames])
+        self.assertLess(100 * into_current, current)
+        self.assertLess(100 * into_peak, peak)
+
+        # Named tuples are smaller than dictionaries.
+        decoded = message.decode(frames[0])
+        decoded_tuple = message.decode(frames[0], as_tuple=True)
+        self.assertEqual(tuple(decoded.values()), tuple(decoded_tuple))
+        self.assertLess(sys.getsizeof(decoded_tuple), sys.getsizeof(decoded))
+
+    def test_decode_lazy(self):
+        db = cantools.database.load_file('tests/files/dbc/multiplex_2.dbc')
+        message = db.get_message_by_name('Extended')
+        data = b'\x00\x11\x22\x33\x01\xff\xee\x00'
+        decoded = message.decode(data, lazy=True)
+
+        self.assertIsInstance(decoded, cantools.database.can.LazyDecodedMessage)
+        self.assertEqual(decoded['S3'], 0x3322)
+        self.assertEqual(decoded.get('S3'), 0x3322)
+        self.assertNotIn('S5', decoded)
+        self.assertIsNone(decoded.get('S5'))
+        self.assertEqual(decoded, message.decode(data))
+        self.assertEqual(list(decoded), list(message.decode(data)))
+        self.assertEqual(len(decoded), 6)
+
+        with self.assertRaises(TypeError):
+            decoded['S3'] = 1
+
+        # Multiplexer errors are raised on access.
+        decoded = message.decode(b'\x02\x11\x22\x33\x01\xff\xee\x00',
+                                 lazy=True)
+
+        with self.assertRaises(cantools.database.DecodeError):
+            decoded['S7']
+
+        # Not multiplexed messages.
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        data = b'\xc0\x06\xe0\x00\x00\x00\x00\x00'
+        decoded = db.decode_message('ExampleMessage', data, lazy=True)
+
+        # Signals are decoded one by one, not the whole message.
+        with patch.object(cantools.database.can.Message,
+                          'decode',
+                          side_effect=AssertionError):
+            self.assertEqual(list(decoded),
+                             ['Enable', 'AverageRadius', 'Temperature'])
+            self.assertEqual(len(decoded), 3)
+            self.assertIn('Temperature', decoded)
+            self.assertEqual(decoded['Enable'], 'Enabled')
+
+        self.assertEqual(dict(decoded), db.decode_message(0x1f0, data))
+        self.assertEqual(
+            repr(db.decode_message(0x1f0, data, scaling=False, lazy=True)),
+            "{'Enable': Enabled, 'AverageRadius': 32, 'Temperature': 55}")
+
+    def test_decode_cache(self):
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        message = db.get_message_by_name('ExampleMessage')
+        data_1 = b'\xc0\x06\xe0\x00\x00\x00\x00\x00'
+        data_2 = b'\x80\x4a\x0f\x00\x00\x00\x00\x00'
+        expected_1 = message.decode(data_1)
+        expected_2 = message.decode(data_2)
+        self.assertIsNone(message.decode_cache)
+
+        # Last value cache.
+        db.enable_decode_cache()
+        cache = message.decode_cache
+        decoded = message.decode(data_1)
+        self.assertEqual(decoded, expected_1)
+        self.assertIs(message.decode(bytearray(data_1)), decoded)
+        self.assertEqual(message.decode(data_1, scaling=False),
+                         message._decode_uncached(data_1, True, False))
+        self.assertEqual(message.decode(data_1), expected_1)
+        self.assertEqual(message.decode(data_2), expected_2)
+        self.assertEqual((cache.hits, cache.misses), (1, 4))
+        self.assertEqual(len(cache), 1)
+
+        with self.assertRaises(TypeError):
+            decoded['Enable'] = 0
+
+        # LRU cache.
+        message.enable_decode_cache(2)
+        cache = message.decode_cache
+
+        for data in [data_1, data_2, data_1, data_2, data_1]:
+            message.decode(data)
+
+        self.assertEqual((cache.hits, cache.misses), (3, 2))
+        self.assertEqual(repr(cache), 'decode_cache(size=2, hits=3, misses=2)')
+
+        # Selected signals and lazy decoding are not cached.
+        message.decode(data_1, signals=['Enable'])
+        message.decode(data_1, lazy=True)
+        self.assertEqual((cache.hits, cache.misses), (3, 2))
+
+        # Cleared on refresh.
+        db.refresh()
+        self.assertEqual((cache.hits, cache.misses, len(cache)), (0, 0, 0))
+
+        db.disable_decode_cache()
+        self.assertIsNone(message.decode_cache)
+        self.assertIsInstance(message.decode(data_1), dict)
+
+        with self.assertRaises(ValueError) as cm:
+            message.enable_decode_cache(0)
+
+        self.assertEqual(str(cm.exception),
+                         'Expected decode cache size at least 1, but got 0.')
+
+    def test_projection(self):
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        data = b'\xc0\x06\xe0\x00\x00\x00\x00\x00'
+
+        projection = db.projection(['Temperature', 'Enable'])
+        self.assertEqual(projection.signals('ExampleMessage'),
+                         {'Temperature', 'Enable'})
+        self.assertEqual(projection.decode_message(0x1f0, data),
+                         {'Temperature': 250.55, 'Enable': 'Enabled'})
+        self.assertEqual(
+            projection.decode_message('ExampleMessage',
+                                      data,
+                                      decode_choices=False,
+                                      scaling=False),
+            {'Temperature': 55, 'Enable': 1})
+
+        projection = db.projection(
+            lambda message, signal: signal.name.startswith('Average'))
+        self.assertEqual(projection.decode_message(0x1f0, data),
+                         {'AverageRadius': 3.2})
+
+        # Invalid multiplexer ids are reported also for messages
+        # without selected signals.
+        db = cantools.database.load_file('tests/files/dbc/abs.dbc')
+        projection = db.projection(['whlspeed_FL'])
+        self.assertEqual(projection.signals('BREMSE_52'), set())
+
+        with self.assertRaises(cantools.database.DecodeError) as cm:
+            projection.decode_message('BREMSE_52',
+                                      b'\x00\xa8\xd9\xa5\x37\xe7\x24\xc4')
+
+        self.assertEqual(str(cm.exception),
+                         'expected multiplexer id 1, 2, 3, 4, 5, 6 or 7, '
+                         'but got 0')
+
+    def test_decode_batch(self):
+        try:
+            import numpy
+        except ImportError:
+            self.skipTest('NumPy is not installed.')
+
+        db = cantools.database.load_file('tests/files/dbc/multiplex_2.dbc')
+        message = db.get_message_by_name('Extended')
+        payloads = [
+            b'\x00\x11\x22\x33\x01\xff\xee\x00',
+            b'\x20\x12\x34\x56\x02\x80\x00\x00',
+            b'\x31\x00\x00\x80\x01\x01\x02\x03',
+            b'\xf1\xff\xff\xff\x02\x7f\x00\x00'
+        ]
+
+        for scaling in [False, True]:
+            decoded = message.decode_batch(payloads, scaling=scaling)
+            decoded_from_array = message.decode_batch(
+                numpy.frombuffer(b''.join(payloads), numpy.uint8).reshape(4, 8),
+                scaling=scaling)
+
+            for i, payload in enumerate(payloads):
+                expected = message.decode(payload,
+                                          decode_choices=False,
+                                          scaling=scaling)
+
+                for name, column in decoded.items():
+                    self.assertFalse(
+                        numpy.ma.is_masked(decoded_from_array[name][i])
+                        != numpy.ma.is_masked(column[i]))
+
+                    if numpy.ma.is_masked(column[i]):
+                        self.assertNotIn(name, expected)
+                    else:
+                        self.assertEqual(column[i], expected[name])
+                        self.assertEqual(decoded_from_array[name][i],
+                                         expected[name])
+
+                self.assertEqual(
+                    set(name
+                        for name, column in decoded.items()
+                        if not numpy.ma.is_masked(column[i])),
+                    set(expected))
+
+        # Not multiplexed signals are plain arrays.
+        self.assertNotIsInstance(decoded['S0'], numpy.ma.MaskedArray)
+        self.assertIsInstance(decoded['S1'], numpy.ma.MaskedArray)
+
+        # Too short payloads.
+        with self.assertRaises(cantools.database.DecodeError) as cm:
+            message.decode_batch([b'\x00'])
+
+        self.assertEqual(str(cm.exception),
+                         'Expected at least 8 bytes per frame, but got 1.')
+
+        # Scaled values not fitting in 64 bits are Python integers.
+        message = cantools.db.Message(
+            frame_id=1,
+            name='Scaled',
+            length=12,
+            signals=[
+                cantools.db.Signal('Large', 0, 40, scale=10 ** 8, offset=5),
+                cantools.db.Signal('Small', 48, 8, scale=2, offset=1),
+                cantools.db.Signal('Negative',
+                                   64,
+                                   32,
+                                   is_signed=True,
+                                   scale=-2 ** 33)
+            ],
+            strict=False)
+        payloads = [
+            b'\xff' * 8 + b'\x00\x00\x00\x80',
+            b'\x00' * 12
+        ]
+        decoded = message.decode_batch(payloads)
+
+        for i, payload in enumerate(payloads):
+            for name, value in message.decode(payload).items():
+                self.assertEqual(decoded[name][i], value)
+
+        self.assertEqual(decoded['Large'][0], 109951162777500000005)
+        self.assertEqual(decoded['Negative'][0], 2 ** 64)
+        self.assertEqual(decoded['Large'].dtype, object)
+        self.assertEqual(decoded['Negative'].dtype, object)
+        self.assertEqual(decoded['Small'].dtype, numpy.int64)
+
+    def test_precompile(self):
+        db = cantools.database.load_file('tests/files/dbc/multiplex_2.dbc')
+        message = db.get_message_by_name('Extended')
+        data = {'S0': 0, 'S1': 2, 'S4': -1, 'S6': 2, 'S8': 3}
+        encoded = b'\x20\xff\xff\xff\x02\x03\x00\x00'
+
+        # Codecs are created on first use.
+        self.assertNotIn('formats', message._codecs)
+        self.assertEqual(message.encode(data), encoded)
+        self.assertEqual(message._encode_generic(data, True, False, True),
+                         encoded)
+        self.assertIn('formats', message._codecs)
+
+        message.refresh()
+        self.assertNotIn('formats', message._codecs)
+        db.precompile()
+        self.assertIn('formats', message._codecs)
+
+        for child in message._codecs['multiplexers']['S0'].values():
+            self.assertIn('formats', child)
+
+        self.assertNotEqual(message._decoder, message._generate_decoder)
+        self.assertNotEqual(message._encoder, message._generate_encoder)
+        self.assertEqual(message.encode(data), encoded)
+        self.assertEqual(message.decode(encoded), data)
+
+    def test_encode_values(self):
+        db = cantools.database.load_file('tests/files/dbc/foobar.dbc')
+        foo = db.get_message_by_name('Foo')
+        fum = db.get_message_by_name('Fum')
+        self.assertEqual([signal.name for signal in foo.signals],
+                         ['Foo', 'Bar'])
+
+        for kwargs in [{},
+                       {'scaling': False},
+                       {'padding': True},
+                       {'strict': False}]:
+            encode = foo.encoder(**kwargs)
+            self.assertIs(foo.encoder(**kwargs), encode)
+
+            if kwargs.get('scaling') is False:
+                rows = [(0, 10), (-2000, 1), (2000, 50)]
+            else:
+                rows = [(250, 1), (229.53, 0.05), (270, 5)]
+
+            for values in rows:
+                expected = foo.encode(dict(zip(['Foo', 'Bar'], values)),
+                                      **kwargs)
+                self.assertEqual(encode(*values), expected)
+                self.assertEqual(foo.encode_values(*values, **kwargs),
+                                 expected)
+
+        self.assertEqual(fum.encode_values(1, 'Enabled'),
+                         fum.encode({'Fum': 1, 'Fam': 'Enabled'}))
+
+        # Values of signals in multiplexer branches not selected are
+        # ignored.
+        db = cantools.database.load_file('tests/files/dbc/multiplex_2.dbc')
+        extended = db.get_message_by_name('Extended')
+        self.assertEqual([signal.name for signal in extended.signals],
+                         ['S0', 'S5', 'S1', 'S4', 'S2', 'S3', 'S6', 'S8', 'S7'])
+        self.assertEqual(
+            extended.encode_values(1, 5, None, None, None, None, 1, None, 7),
+            extended.encode({'S0': 1, 'S5': 5, 'S6': 1, 'S7': 7}))
+
+        # The errors are the same as of encode().
+        with self.assertRaises(cantools.database.EncodeError) as cm:
+            foo.encode_values(229.52, 1)
+
+        self.assertEqual(
+            str(cm.exception),
+            "Expected signal 'Foo' value greater than or equal to 229.53 in "
+            "message 'Foo', but got 229.52.")
+
+        with self.assertRaises(cantools.database.EncodeError) as cm:
+            extended.encode_values(3, 5, None, None, None, None, 1, None, 7)
+
+        self.assertEqual(str(cm.exception),
+                         'expected multiplexer id 0 or 1, but got 3')
+
+        # The number of values is checked by both the generated and
+        # the generic encoder.
+        with self.assertRaises(cantools.database.EncodeError) as cm:
+            foo.encode_values(250)
+
+        self.assertEqual(str(cm.exception),
+                         "Expected 2 signal values in message 'Foo', but got 1.")
+
+        foo.refresh()
+
+        with patch('cantools.database.can.message.generate_values_encoder',
+                   return_value=None):
+            with self.assertRaises(cantools.database.EncodeError) as cm:
+                foo.encode_values(250, 1, 2)
+
+        self.assertEqual(str(cm.exception),
+                         "Expected 2 signal values in message 'Foo', but got 3.")
+
+        # New encoders are generated when the message is refreshed.
+        encode = foo.encoder()
+        foo.refresh()
+        self.assertIsNot(foo.encoder(), encode)
+
+    def test_encode_batch(self):
+        try:
+            import numpy
+        except ImportError:
+            numpy = None
+
+        def assert_encode_batch(message, rows, **kwargs):
+            expected = [message.encode(row, **kwargs) for row in rows]
+            self.assertEqual(message.encode_batch(rows, **kwargs), expected)
+            self.assertEqual(message.encode_batch(rows, join=True, **kwargs),
+                             b''.join(expected))
+
+            if not message.is_multiplexed():
+                columns = {
+                    name: [row[name] for row in rows]
+                    for name in rows[0]
+                }
+                self.assertEqual(message.encode_batch(columns, **kwargs),
+                                 expected)
+
+                if numpy is not None:
+                    # Choice strings are kept in lists.
+                    arrays = {
+                        name: (column
+                               if any(isinstance(value, str) for value in column)
+                               else numpy.array(column))
+                        for name, column in columns.items()
+                    }
+                    self.assertEqual(message.encode_batch(arrays, **kwargs),
+                                     expected)
+
+        def assert_encode_batch_error(message, columns, **kwargs):
+            with self.assertRaises(cantools.database.EncodeError) as cm:
+                message.encode_batch(columns, **kwargs)
+
+            return str(cm.exception)
+
+        db = cantools.database.load_file('tests/files/dbc/foobar.dbc')
+        foo = db.get_message_by_name('Foo')
+        fum = db.get_message_by_name('Fum')
+        can_fd = db.get_message_by_name('CanFd')
+        db_mux = cantools.database.load_file('tests/files/dbc/multiplex_2.dbc')
+        extended = db_mux.get_message_by_name('Extended')
+        payloads = [
+            b'\x00\x11\x22\x33\x01\xff\xee\x00',
+            b'\x20\x12\x34\x56\x02\x80\x00\x00',
+            b'\x31\x00\x00\x80\x01\x01\x02\x03',
+            b'\xf1\xff\xff\xff\x02\x7f\x00\x00'
+        ]
+
+        # With and without NumPy.
+        for find_numpy in [lambda: numpy, lambda: None]:
+            with patch('cantools.database.can.message._find_numpy',
+                       find_numpy):
+                for scaling in [False, True]:
+                    for padding in [False, True]:
+                        assert_encode_batch(
+                            extended,
+                            [extended.decode(payload, scaling=scaling)
+                             for payload in payloads],
+                            scaling=scaling,
+                            padding=padding)
+
+                assert_encode_batch(foo,
+                                    [
+                                        {'Foo': 229.53, 'Bar': 0},
+                                        {'Foo': 250, 'Bar': 0.05},
+                                        {'Foo': 270.47, 'Bar': 5}
+                                    ])
+                assert_encode_batch(fum,
+                                    [
+                                        {'Fum': 1, 'Fam': 'Enabled'},
+                                        {'Fum': 10, 'Fam': 0}
+                                    ],
+                                    padding=True)
+                assert_encode_batch(can_fd,
+                                    [
+                                        {'Fie': 0, 'Fas': 1},
+                                        {'Fie': 2 ** 63 - 1, 'Fas': 2 ** 62}
+                                    ])
+                self.assertEqual(foo.encode_batch({'Foo': [], 'Bar': []}), [])
+                self.assertEqual(
+                    foo.encode_batch({'Foo': [], 'Bar': []}, join=True),
+                    b'')
+
+                # Values of signals in multiplexer branches not
+                # selected are ignored.
+                self.assertEqual(
+                    extended.encode_batch({
+                        'S0': [0, 1],
+                        'S1': [2, None],
+                        'S4': [-1, None],
+                        'S5': [None, 5],
+                        'S6': [2, 1],
+                        'S7': [None, 7],
+                        'S8': [3, None]
+                    }),
+                    [
+                        extended.encode({'S0': 0, 'S1': 2, 'S4': -1,
+                                         'S6': 2, 'S8': 3}),
+                        extended.encode({'S0': 1, 'S5': 5, 'S6': 1, 'S7': 7})
+                    ])
+
+                # The errors are the same as when encoding one row at
+                # a time.
+                self.assertEqual(
+                    assert_encode_batch_error(foo, {'Foo': [250, 229.52],
+                                                    'Bar': [1, 1]}),
+                    "Expected signal 'Foo' value greater than or equal to "
+                    "229.53 in message 'Foo', but got 229.52.")
+                self.assertEqual(
+                    assert_encode_batch_error(foo, {'Foo': [250, 250]}),
+                    "Expected signal value for 'Bar' in data, but got "
+                    "{'Foo': 250}.")
+                self.assertEqual(
+                    assert_encode_batch_error(extended, {'S0': [1, 3],
+                                                         'S5': [5, 5],
+                                                         'S6': [1, 1],
+                                                         'S7': [7, 7]}),
+                    'expected multiplexer id 0 or 1, but got 3')
+
+                with self.assertRaises(cantools.database.EncodeError) as cm:
+                    foo.encode_batch({'Foo': [250, 250], 'Bar': [1]})
+
+                self.assertEqual(
+                    str(cm.exception),
+                    "Expected columns of equal lengths, but got "
+                    "{'Foo': 2, 'Bar': 1}.")
+
+    def test_decode_frames(self):
+        try:
+            import numpy
+        except ImportError:
+            self.skipTest('NumPy is not installed.')
+
+        db = cantools.database.load_file('tests/files/dbc/motohawk.dbc')
+        frame_ids = [0x1f0, 0x123, 0x1f0]
+        payloads = [
+            b'\xc0\x06\xe0\x00\x00\x00\x00\x00',
+            b'\x00',
+            b'\x80\x4a\x0f\x00\x00\x00\x00\x00'
+        ]
+        decoded = db.decode_frames(frame_ids, payloads, [0.5, 1.0, 1.5])
+
+        self.assertEqual(list(decoded), ['ExampleMessage'])
+        timestamps, signals = decoded['ExampleMessage']
+        self.assertEqual(timestamps.tolist(), [0.5, 1.5])
+
+        for i, payload in enumerate([payloads[0], payloads[2]]):
+            expected = db.decode_message(0x1f0, payload, decode_choices=False)
+
+            for name, value in expected.items():
+                self.assertAlmostEqual(signals[name][i], value)
+
+        timestamps, _ = db.decode_frames(frame_ids, payloads)['ExampleMessage']
+        self.assertEqual(timestamps.tolist(), [0, 2])
+
 
 # This file is not '__main__' when executed via 'python setup.py3
 # test'.
@@ -24,6 +24,7 @@ class Args(object):
         self.encoding = None
         self.frame_id_mask = None
         self.no_strict = False
+        self.cache_dir = None
         self.single_line = single_line
         self.bit_rate = None
         self.fd = False
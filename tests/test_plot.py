@@ -962,6 +962,48 @@ Failed to parse line: 'invalid syntax'
                         for i in range(len(expected_subplot_calls)):
                             self.assertListEqual(subplots[i].mock_calls, expected_subplot_calls[i], msg="calls don't match for subplot %s" % i)
 
+    def test_error_messages_multiplexed_message_without_plotted_signals(self):
+        dbc_file = os.path.join(os.path.split(__file__)[0], 'files/dbc/multiplex_2.dbc')
+        argv = ['cantools', 'plot', dbc_file, 'Normal.S1']
+        input_data = """\
+ (2020-12-29 11:33:24.285921)  vcan0  0C01FEFE   [8]  10 00 00 00 00 00 00 00
+ (2020-12-29 11:33:24.286209)  vcan0  0C02FEFE   [8]  06 00 00 00 00 00 00 00
+ (2020-12-29 11:33:25.288070)  vcan0  0C01FEFE   [8]  20 00 00 00 00 00 00 00
+"""
+        expected_output = """\
+Failed to parse data of frame id 201522942 (0xc02fefe): ...
+"""
+        xs = [
+            datetime.datetime(2020, 12, 29, 11, 33, 24, 285921),
+            datetime.datetime(2020, 12, 29, 11, 33, 25, 288070),
+        ]
+
+        subplots = [SubplotMock()]
+        plt = PyplotMock()
+        plt.subplot.side_effect = subplots
+        expected_calls = [
+            mock.call.subplot(1,1,1, sharex=None),
+            mock.call.show(),
+        ]
+        expected_subplot_calls = [
+            mock.call.plot(xs, [1, 2], '', label='Normal.S1'),
+            mock.call.set_xlabel(self.XLABEL_tA % "29.12.2020"),
+        ]
+
+        stdout = StringIO()
+
+        with mock.patch('sys.stdin', StringIO(input_data)):
+            with mock.patch('sys.stdout', stdout):
+                with mock.patch('sys.argv', argv):
+                    with plt:
+                        cantools._main()
+
+                        actual_output = stdout.getvalue()
+                        self.assertLinesMatch(actual_output, expected_output)
+
+                        self.assertListEqual(plt.mock_calls, expected_calls)
+                        self.assertListEqual(subplots[0].mock_calls, expected_subplot_calls)
+
 
     # --ignore-*
 